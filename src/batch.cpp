@@ -0,0 +1,247 @@
+#include <string>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
+#include <iostream>
+#include "model.hpp"
+#include "frame_sink.hpp"
+#include "recording.hpp"
+#include "checkpoint.hpp"
+
+// Calcul sans affichage (noeuds de calcul sans écran) : le modèle tourne jusqu'à l'extinction du feu ou
+// jusqu'au nombre de pas demandé, à pleine vitesse, avec des images périodiques en option.
+// Aucune dépendance à SDL ni à MPI. Les points de sauvegarde permettent de reprendre un long calcul
+// interrompu : la reprise donne exactement la même suite de pas.
+struct ParamsType {
+    double length{1.};
+    unsigned discretization{100u};
+    std::array<double,2> wind{0.,0.};
+    std::array<double,2> start{0.5,0.5};  // Position du foyer, en fraction du terrain
+    Model::Engine engine{Model::Engine::sparse};
+    std::uint64_t seed{0};
+    unsigned threads{0};                  // 0 : nombre de threads OpenMP par défaut
+    std::size_t max_steps{0};             // 0 : jusqu'à l'extinction du feu
+    unsigned snapshot_interval{0};        // Image tous les snapshot_interval pas (0 : aucune)
+    std::string snapshot_prefix{"snapshot"};
+    std::string record;                   // Enregistrement de chaque pas (relu par replay.exe), vide : aucun
+    unsigned checkpoint_interval{0};      // Point de sauvegarde tous les checkpoint_interval pas (0 : aucun)
+    std::string checkpoint;
+    std::string restart;                  // Point de sauvegarde à reprendre, vide : départ du foyer
+};
+
+bool analyze_arg(int nargs, char* args[], ParamsType& params) {
+    for (int i = 1; i < nargs; ++i) {
+        std::string arg = args[i];
+        // Vrai si l'option est suivie de ses nb_values valeurs
+        auto has_values = [&](int nb_values) {
+            if (i + nb_values < nargs) return true;
+            std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
+            return false;
+        };
+        if (arg == "-l" || arg == "--length") {
+            if (!has_values(1)) return false;
+            params.length = std::stod(args[++i]);
+        }
+        else if (arg == "-d" || arg == "--discretization") {
+            if (!has_values(1)) return false;
+            params.discretization = std::stoul(args[++i]);
+        }
+        else if (arg == "-w" || arg == "--wind") {
+            if (!has_values(2)) return false;
+            params.wind[0] = std::stod(args[++i]);
+            params.wind[1] = std::stod(args[++i]);
+        }
+        else if (arg == "-s" || arg == "--start") {
+            if (!has_values(2)) return false;
+            params.start[0] = std::stod(args[++i]);
+            params.start[1] = std::stod(args[++i]);
+        }
+        else if (arg == "-e" || arg == "--engine") {
+            if (!has_values(1)) return false;
+            std::string name = args[++i];
+            if (name != "sparse" && name != "dense") {
+                std::cerr << "[ERREUR] Moteur inconnu : " << name << " (sparse ou dense)" << std::endl;
+                return false;
+            }
+            params.engine = name == "dense" ? Model::Engine::dense : Model::Engine::sparse;
+        }
+        else if (arg == "--seed") {
+            if (!has_values(1)) return false;
+            params.seed = std::stoull(args[++i]);
+        }
+        else if (arg == "-t" || arg == "--threads") {
+            if (!has_values(1)) return false;
+            params.threads = std::stoul(args[++i]);
+        }
+        else if (arg == "-n" || arg == "--steps") {
+            if (!has_values(1)) return false;
+            params.max_steps = std::stoull(args[++i]);
+        }
+        else if (arg == "--snapshot") {
+            if (!has_values(1)) return false;
+            params.snapshot_interval = std::stoul(args[++i]);
+        }
+        else if (arg == "--snapshot-prefix") {
+            if (!has_values(1)) return false;
+            params.snapshot_prefix = args[++i];
+        }
+        else if (arg == "--record") {
+            if (!has_values(1)) return false;
+            params.record = args[++i];
+        }
+        else if (arg == "--checkpoint") {
+            if (!has_values(2)) return false;
+            params.checkpoint_interval = std::stoul(args[++i]);
+            params.checkpoint = args[++i];
+        }
+        else if (arg == "--restart") {
+            if (!has_values(1)) return false;
+            params.restart = args[++i];
+        }
+        else {
+            if (arg != "-h" && arg != "--help")
+                std::cerr << "[ERREUR] Option inconnue : " << arg << std::endl;
+            std::cout << "Usage : " << args[0] << " [-l longueur] [-d cases] [-w vx vy] [-s x y] [-e sparse|dense]\n"
+                      << "        [--seed graine] [-t threads] [-n pas] [--snapshot intervalle] [--snapshot-prefix préfixe]\n"
+                      << "        [--record fichier] [--checkpoint intervalle fichier] [--restart fichier]"
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool check_params(ParamsType const& params) {
+    if (params.length <= 0) {
+        std::cerr << "[ERREUR] La longueur doit être positive." << std::endl;
+        return false;
+    }
+    if (params.discretization == 0) {
+        std::cerr << "[ERREUR] Le nombre de cellules doit être positif." << std::endl;
+        return false;
+    }
+    if (params.start[0] < 0 || params.start[0] > 1 || params.start[1] < 0 || params.start[1] > 1) {
+        std::cerr << "[ERREUR] La position du foyer doit être entre 0 et 1." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Modèle au départ du foyer, ou repris d'un point de sauvegarde : les paramètres du modèle sont alors
+// ceux de la simulation sauvegardée
+Model start_model(ParamsType& params) {
+    if (params.restart.empty()) {
+        const unsigned d = params.discretization;
+        return Model(params.length, d, params.wind,
+                     {std::min(unsigned(params.start[0] * d), d - 1), std::min(unsigned(params.start[1] * d), d - 1)},
+                     10.0, params.seed);
+    }
+    try {
+        Model model = load_checkpoint(params.restart);
+        params.length = model.length();
+        params.discretization = model.geometry();
+        params.wind = model.wind();
+        params.seed = model.seed();
+        std::cout << "Reprise de " << params.restart << " au pas " << model.time_step() << std::endl;
+        return model;
+    }
+    catch (std::exception const& error) {
+        std::cerr << "[ERREUR] " << error.what() << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+int main(int nargs, char* args[]) {
+    ParamsType params;
+    if (!analyze_arg(nargs, args, params) || !check_params(params))
+        return EXIT_FAILURE;
+
+    Model simu = start_model(params);
+    const unsigned d = params.discretization;
+    simu.set_engine(params.engine);
+    if (params.threads > 0) simu.set_threads(params.threads);
+
+    std::unique_ptr<FrameSink> snapshots;
+    std::unique_ptr<RecordingSink> recorder;
+    if (params.snapshot_interval > 0) {
+        snapshots = std::make_unique<SnapshotSink>(params.snapshot_prefix, params.snapshot_interval, d, d);
+        snapshots->write(simu.time_step(), simu.vegetal_map(), simu.fire_map(), false);
+    }
+    if (!params.record.empty()) {
+        try {
+            recorder = std::make_unique<RecordingSink>(params.record, d, d, params.length, params.wind, params.seed);
+        }
+        catch (std::exception const& error) {
+            std::cerr << "[ERREUR] " << error.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+        recorder->write(simu.time_step(), simu.vegetal_map(), simu.fire_map(), false);
+    }
+
+    std::size_t iteration = 0, nb_checkpoints = 0;
+    auto update_time = std::chrono::steady_clock::duration::zero();
+    auto record_time = std::chrono::steady_clock::duration::zero();
+    auto checkpoint_time = std::chrono::steady_clock::duration::zero();
+    auto checkpoint = [&]() {
+        auto checkpoint_start = std::chrono::steady_clock::now();
+        try {
+            save_checkpoint(simu, params.checkpoint);
+        }
+        catch (std::exception const& error) {
+            std::cerr << "[ERREUR] " << error.what() << std::endl;
+            return false;
+        }
+        checkpoint_time += std::chrono::steady_clock::now() - checkpoint_start;
+        nb_checkpoints++;
+        return true;
+    };
+    bool running = true;
+    while (running && (params.max_steps == 0 || iteration < params.max_steps)) {
+        auto step_start = std::chrono::steady_clock::now();
+        running = simu.update();
+        update_time += std::chrono::steady_clock::now() - step_start;
+        iteration++;
+        if (snapshots) {
+            bool last = !running || iteration == params.max_steps;
+            snapshots->write(simu.time_step(), simu.vegetal_map(), simu.fire_map(), last);
+        }
+        if (recorder) {
+            auto record_start = std::chrono::steady_clock::now();
+            recorder->write(simu.time_step(), simu.vegetal_map(), simu.fire_map(), !running);
+            record_time += std::chrono::steady_clock::now() - record_start;
+        }
+        // Sauvegarde périodique, et à l'arrêt sur le nombre de pas pour pouvoir prolonger le calcul
+        if (params.checkpoint_interval > 0 && running
+            && (simu.time_step() % params.checkpoint_interval == 0 || iteration == params.max_steps)) {
+            if (!checkpoint())
+                return EXIT_FAILURE;
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(update_time).count();
+    std::cout << "Pas de temps : " << iteration << (running ? " (nombre de pas atteint)" : " (feu éteint)")
+              << " - temps de calcul : " << seconds << " s"
+              << " - " << seconds / std::max<std::size_t>(iteration, 1) * 1000 << " ms par pas"
+              << " (" << iteration / seconds << " pas/s)" << std::endl;
+    std::cout << "Taille finale du front : " << simu.fire_front().size() << std::endl;
+    if (nb_checkpoints > 0)
+        std::cout << "Points de sauvegarde : " << nb_checkpoints << " (" << params.checkpoint << ") - écriture : "
+                  << std::chrono::duration<double>(checkpoint_time).count() << " s" << std::endl;
+    if (snapshots)
+        std::cout << "Images enregistrées : " << snapshots->written() << std::endl;
+    if (recorder) {
+        // Temps pris au calcul par le codage des trames ; la fin des écritures est attendue à part
+        auto close_start = std::chrono::steady_clock::now();
+        recorder->close();
+        double record_seconds = std::chrono::duration<double>(record_time).count();
+        double close_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - close_start).count();
+        std::cout << "Enregistrement : " << recorder->written() << " trames, " << recorder->bytes() << " octets"
+                  << " - codage : " << record_seconds << " s (" << 100 * record_seconds / seconds << " % du calcul)"
+                  << " - fin d'écriture : " << close_seconds << " s" << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
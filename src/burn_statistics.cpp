@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include "burn_statistics.hpp"
+
+BurnStatistics::BurnStatistics( unsigned t_geometry )
+    :   m_geometry(t_geometry),
+        m_counts(std::size_t(t_geometry)*t_geometry, 0u),
+        m_arrival_sums(std::size_t(t_geometry)*t_geometry, 0u),
+        m_arrival_squares(std::size_t(t_geometry)*t_geometry, 0u),
+        m_arrival(std::size_t(t_geometry)*t_geometry, not_burnt)
+{}
+// --------------------------------------------------------------------------------------------------------------------
+void
+BurnStatistics::observe( Model const& t_model )
+{
+    m_tracked = 1;
+    // Cases du front : toute case allumée y figure au moins le pas de son allumage
+    const std::uint32_t step = std::uint32_t(t_model.time_step());
+    for (auto cell : t_model.fire_front())
+    {
+        if (cell.intensity == 0 || m_arrival[cell.index] != not_burnt) continue;
+        m_arrival[cell.index] = step;
+        m_burnt.push_back(std::uint32_t(cell.index));
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+BurnStatistics::observe( EnsembleModel const& t_model )
+{
+    // Le tableau des pas d'allumage s'agrandit au premier lot plus large que les précédents
+    const unsigned nb_members = t_model.members();
+    m_tracked = nb_members;
+    if (m_arrival.size() < m_counts.size()*nb_members)
+        m_arrival.resize(m_counts.size()*nb_members, not_burnt);
+    const std::uint32_t step = std::uint32_t(t_model.time_step());
+    for (auto cell : t_model.active_cells())
+        for (unsigned k = 0; k < nb_members; ++k)
+        {
+            const std::uint32_t entry = cell*nb_members + k;
+            if (t_model.intensity(cell, k) == 0 || m_arrival[entry] != not_burnt) continue;
+            m_arrival[entry] = step;
+            m_burnt.push_back(entry);
+        }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+BurnStatistics::finish_member()
+{
+    for (auto entry : m_burnt)
+    {
+        const std::size_t cell = entry/m_tracked;
+        const std::uint64_t step = m_arrival[entry];
+        m_counts[cell]++;
+        m_arrival_sums[cell]    += step;
+        m_arrival_squares[cell] += step*step;
+        m_arrival[entry] = not_burnt;
+    }
+    m_burnt.clear();
+    m_members += m_tracked;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+BurnStatistics::merge( BurnStatistics const& t_other )
+{
+    if (t_other.m_geometry != m_geometry)
+    {
+        throw std::range_error("Les statistiques réunies doivent porter sur la même grille.");
+    }
+    for (std::size_t cell = 0; cell < m_counts.size(); ++cell)
+    {
+        m_counts[cell]          += t_other.m_counts[cell];
+        m_arrival_sums[cell]    += t_other.m_arrival_sums[cell];
+        m_arrival_squares[cell] += t_other.m_arrival_squares[cell];
+    }
+    m_members += t_other.m_members;
+}
+// --------------------------------------------------------------------------------------------------------------------
+double
+BurnStatistics::probability( std::size_t t_cell ) const
+{
+    return m_members == 0 ? 0. : double(m_counts[t_cell])/double(m_members);
+}
+// --------------------------------------------------------------------------------------------------------------------
+double
+BurnStatistics::mean_arrival( std::size_t t_cell ) const
+{
+    return m_counts[t_cell] == 0 ? 0. : double(m_arrival_sums[t_cell])/m_counts[t_cell];
+}
+// --------------------------------------------------------------------------------------------------------------------
+double
+BurnStatistics::std_arrival( std::size_t t_cell ) const
+{
+    if (m_counts[t_cell] == 0) return 0.;
+    const double mean = mean_arrival(t_cell);
+    return std::sqrt(std::max(0., double(m_arrival_squares[t_cell])/m_counts[t_cell] - mean*mean));
+}
+// --------------------------------------------------------------------------------------------------------------------
+bool
+BurnStatistics::write( std::string const& t_prefix ) const
+{
+    const std::size_t nb_cells = m_counts.size();
+    std::vector<std::uint8_t> probability_map(nb_cells), arrival_map(nb_cells);
+    double latest = 0.;
+    for (std::size_t cell = 0; cell < nb_cells; ++cell)
+        latest = std::max(latest, mean_arrival(cell));
+    for (std::size_t cell = 0; cell < nb_cells; ++cell)
+    {
+        probability_map[cell] = std::uint8_t(std::lround(255.*probability(cell)));
+        arrival_map[cell]     = latest > 0. ? std::uint8_t(std::lround(255.*mean_arrival(cell)/latest)) : 0u;
+    }
+
+    bool success = true;
+    for (auto const& [suffix, map] : {std::pair{"_probability.pgm", &probability_map}, std::pair{"_arrival.pgm", &arrival_map}})
+    {
+        std::ofstream file(t_prefix + suffix, std::ios::binary);
+        file << "P5\n" << m_geometry << " " << m_geometry << "\n255\n";
+        file.write(reinterpret_cast<char const*>(map->data()), std::streamsize(map->size()));
+        if (!file)
+        {
+            std::cerr << "[ERREUR] Écriture impossible : " << t_prefix + suffix << std::endl;
+            success = false;
+        }
+    }
+
+    std::ofstream file(t_prefix + ".csv");
+    file << "row,column,probability,mean_arrival,std_arrival\n";
+    for (std::size_t cell = 0; cell < nb_cells; ++cell)
+        if (m_counts[cell] > 0)
+            file << cell/m_geometry << "," << cell%m_geometry << "," << probability(cell) << ","
+                 << mean_arrival(cell) << "," << std_arrival(cell) << "\n";
+    if (!file)
+    {
+        std::cerr << "[ERREUR] Écriture impossible : " << t_prefix + ".csv" << std::endl;
+        success = false;
+    }
+    return success;
+}
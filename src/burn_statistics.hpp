@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "model.hpp"
+#include "ensemble_model.hpp"
+
+/**
+ * @brief Statistiques de brûlage d'un ensemble de simulations du même terrain (Monte-Carlo).
+ *
+ * Pour chaque case : nombre de membres où elle a brûlé, somme et somme des carrés de son pas
+ * d'allumage (temps d'arrivée du feu). Un membre est suivi pendant son calcul : observe() après chaque
+ * pas relève les cases du front encore jamais vues, finish_member() les ajoute aux totaux. Le coût
+ * est proportionnel à la taille du front, pas à celle de la grille. Les membres d'un EnsembleModel
+ * sont suivis ensemble, de la même façon.
+ *
+ * Les totaux sont des entiers : la somme de plusieurs ensembles (merge(), ou MPI_Reduce sur counts(),
+ * arrival_sums() et arrival_squares()) ne dépend pas de l'ordre des membres.
+ */
+class BurnStatistics
+{
+public:
+    explicit BurnStatistics( unsigned t_geometry );
+
+    // Suivi du membre en cours : à appeler avant le premier pas (foyer) puis après chaque pas
+    void observe( Model const& t_model );
+    void observe( EnsembleModel const& t_model );
+    // Ajoute aux totaux le membre (ou les membres de l'EnsembleModel) suivi
+    void finish_member();
+    // Ajoute les totaux d'un autre ensemble de même géométrie
+    void merge( BurnStatistics const& t_other );
+
+    unsigned      geometry() const { return m_geometry; }
+    std::uint64_t members() const { return m_members; }
+    std::vector<std::uint32_t>&       counts()       { return m_counts; }
+    std::vector<std::uint32_t> const& counts() const { return m_counts; }
+    std::vector<std::uint64_t>&       arrival_sums()       { return m_arrival_sums; }
+    std::vector<std::uint64_t> const& arrival_sums() const { return m_arrival_sums; }
+    std::vector<std::uint64_t>&       arrival_squares()       { return m_arrival_squares; }
+    std::vector<std::uint64_t> const& arrival_squares() const { return m_arrival_squares; }
+    void          set_members( std::uint64_t t_members ) { m_members = t_members; }
+
+    // Probabilité de brûlage d'une case, moyenne et écart-type de son temps d'arrivée (parmi les
+    // membres où elle a brûlé ; 0 si elle n'a jamais brûlé)
+    double probability ( std::size_t t_cell ) const;
+    double mean_arrival( std::size_t t_cell ) const;
+    double std_arrival ( std::size_t t_cell ) const;
+
+    // Cartes finales : t_prefix_probability.pgm (probabilité, 255 = toujours brûlée), t_prefix_arrival.pgm
+    // (temps d'arrivée moyen, relatif au plus tardif) et t_prefix.csv (ligne, colonne, probabilité, moyenne
+    // et écart-type du temps d'arrivée de chaque case brûlée au moins une fois). Renvoie faux en cas d'erreur.
+    bool write( std::string const& t_prefix ) const;
+
+private:
+    static constexpr std::uint32_t not_burnt = ~std::uint32_t(0);
+
+    unsigned m_geometry;
+    std::uint64_t m_members = 0;
+    std::vector<std::uint32_t> m_counts;
+    std::vector<std::uint64_t> m_arrival_sums, m_arrival_squares;
+    // Membres en cours : pas d'allumage de chaque case (case*m_tracked + membre), et liste des entrées
+    // allumées pour la remise à zéro
+    unsigned m_tracked = 1;
+    std::vector<std::uint32_t> m_arrival;
+    std::vector<std::uint32_t> m_burnt;
+};
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cstring>
+#include "channel.hpp"
+
+SendChannel::SendChannel( MPI_Comm t_comm, int t_destination, int t_tag, std::size_t t_max_payload,
+                          unsigned t_nb_slots )
+    :   m_comm(t_comm),
+        m_destination(t_destination),
+        m_tag(t_tag),
+        m_max_payload(t_max_payload),
+        m_slots(t_nb_slots > 0 ? t_nb_slots : 1),
+        m_acquired(m_slots.size())
+{
+    const std::size_t capacity = sizeof(StepHeader) + t_max_payload;
+    std::size_t nb_classes = 1;
+    while ((min_message << (nb_classes - 1)) < capacity) nb_classes += 1;
+    for (auto& slot : m_slots)
+    {
+        slot.buffer.resize(capacity);
+        slot.requests.assign(nb_classes, MPI_REQUEST_NULL);
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+SendChannel::~SendChannel()
+{
+    flush();
+    for (auto& slot : m_slots)
+        for (auto& request : slot.requests)
+            if (request != MPI_REQUEST_NULL) MPI_Request_free(&request);
+}
+// --------------------------------------------------------------------------------------------------------------------
+std::uint8_t*
+SendChannel::acquire()
+{
+    // Les tampons sont utilisés à tour de rôle, dans l'ordre d'envoi
+    Slot& slot = m_slots[m_next];
+    if (slot.active >= 0)
+    {
+        int done;
+        MPI_Test(&slot.requests[slot.active], &done, MPI_STATUS_IGNORE);
+        if (!done) return nullptr;
+        slot.active = -1;
+    }
+    m_acquired = m_next;
+    return slot.buffer.data() + sizeof(StepHeader);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+SendChannel::start( StepHeader const& t_header )
+{
+    Slot& slot = m_slots[m_acquired];
+    std::memcpy(slot.buffer.data(), &t_header, sizeof(StepHeader));
+    const std::size_t size = sizeof(StepHeader) + t_header.payload_size;
+    int size_class = 0;
+    while ((min_message << size_class) < size) size_class += 1;
+    const std::size_t count = std::min(min_message << size_class, slot.buffer.size());
+    MPI_Request& request = slot.requests[size_class];
+    if (request == MPI_REQUEST_NULL)
+        MPI_Send_init(slot.buffer.data(), int(count), MPI_BYTE, m_destination, m_tag, m_comm, &request);
+    MPI_Start(&request);
+    slot.active = size_class;
+    m_next = (m_acquired + 1) % m_slots.size();
+    m_acquired = m_slots.size();
+    m_messages += 1;
+    m_bytes += count;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+SendChannel::flush()
+{
+    for (auto& slot : m_slots)
+    {
+        if (slot.active < 0) continue;
+        MPI_Wait(&slot.requests[slot.active], MPI_STATUS_IGNORE);
+        slot.active = -1;
+    }
+}
+// ====================================================================================================================
+ReceiveChannel::ReceiveChannel( MPI_Comm t_comm, int t_source, int t_tag, std::size_t t_max_payload,
+                                unsigned t_nb_slots )
+    :   m_buffers(t_nb_slots > 0 ? t_nb_slots : 1),
+        m_requests(m_buffers.size(), MPI_REQUEST_NULL)
+{
+    for (std::size_t slot = 0; slot < m_buffers.size(); ++slot)
+    {
+        m_buffers[slot].resize(sizeof(StepHeader) + t_max_payload);
+        MPI_Recv_init(m_buffers[slot].data(), int(m_buffers[slot].size()), MPI_BYTE, t_source, t_tag, t_comm,
+                      &m_requests[slot]);
+    }
+    MPI_Startall(int(m_requests.size()), m_requests.data());
+}
+// --------------------------------------------------------------------------------------------------------------------
+ReceiveChannel::~ReceiveChannel()
+{
+    for (auto& request : m_requests)
+    {
+        MPI_Cancel(&request);
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+        MPI_Request_free(&request);
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+bool
+ReceiveChannel::next( StepHeader& t_header, std::uint8_t const*& t_payload )
+{
+    int done;
+    MPI_Test(&m_requests[m_next], &done, MPI_STATUS_IGNORE);
+    if (!done) return false;
+    std::memcpy(&t_header, m_buffers[m_next].data(), sizeof(StepHeader));
+    if (sizeof(StepHeader) + t_header.payload_size > m_buffers[m_next].size())
+    {
+        t_header.payload = StepHeader::none;
+        t_header.payload_size = 0;
+    }
+    t_payload = m_buffers[m_next].data() + sizeof(StepHeader);
+    m_messages += 1;
+    return true;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+ReceiveChannel::release()
+{
+    MPI_Start(&m_requests[m_next]);
+    m_next = (m_next + 1) % m_requests.size();
+}
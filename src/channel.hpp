@@ -0,0 +1,102 @@
+#pragma once
+#include <mpi.h>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief En-tête d'un message par pas de temps, suivi dans le même tampon de sa charge utile.
+ *
+ * L'état du calcul (pas, poursuite, temps) voyage avec les données : un seul message par pas,
+ * sans appariement d'étiquettes côté réception.
+ */
+struct StepHeader
+{
+    enum Payload : std::uint32_t { none = 0, frame = 1 };
+
+    std::uint64_t step = 0;           // Pas de temps du calcul
+    std::uint32_t running = 1;        // 0 : dernier message du calcul
+    std::uint32_t payload = none;     // Type de la charge utile
+    std::uint32_t payload_size = 0;   // Taille de la charge utile en octets
+    std::uint32_t reserved = 0;
+    double        step_seconds = 0.;  // Durée du dernier pas
+    double        total_seconds = 0.; // Temps de calcul cumulé
+};
+
+/**
+ * @brief Canal d'envoi à requêtes persistantes (MPI_Send_init/MPI_Start).
+ *
+ * Chaque tampon d'envoi est enregistré une fois pour toutes. La taille d'une requête persistante
+ * étant fixe, un message part avec la plus petite classe de taille (puissance de deux, à partir de
+ * min_message octets) qui le contient ; les requêtes de chaque classe sont créées au premier usage
+ * puis réutilisées. Deux tampons au plus sont en vol : un message part dès que l'un est libre.
+ */
+class SendChannel
+{
+public:
+    static constexpr std::size_t min_message = 256;
+
+    SendChannel( MPI_Comm t_comm, int t_destination, int t_tag, std::size_t t_max_payload, unsigned t_nb_slots = 2 );
+    SendChannel( SendChannel const & ) = delete;
+    ~SendChannel();
+
+    SendChannel& operator = ( SendChannel const & ) = delete;
+
+    // Charge utile du prochain message (max_payload() octets), nullptr si tous les tampons sont en vol
+    std::uint8_t* acquire();
+    // Envoie l'en-tête et les t_header.payload_size premiers octets du tampon obtenu par acquire()
+    void start( StepHeader const& t_header );
+    // Attend la fin des envois en cours
+    void flush();
+
+    std::size_t   max_payload() const { return m_max_payload; }
+    std::size_t   messages() const { return m_messages; }
+    std::uint64_t bytes() const { return m_bytes; }  // Volume réellement transmis, classes de taille comprises
+
+private:
+    struct Slot
+    {
+        std::vector<std::uint8_t> buffer;    // En-tête puis charge utile
+        std::vector<MPI_Request>  requests;  // Requête persistante de chaque classe de taille
+        int active = -1;                     // Classe de l'envoi en cours, -1 si le tampon est libre
+    };
+
+    MPI_Comm m_comm;
+    int m_destination, m_tag;
+    std::size_t m_max_payload;
+    std::vector<Slot> m_slots;
+    std::size_t m_next = 0;        // Tampon du prochain message
+    std::size_t m_acquired;        // Tampon rendu par acquire(), m_slots.size() sinon
+    std::size_t m_messages = 0;
+    std::uint64_t m_bytes = 0;
+};
+
+/**
+ * @brief Canal de réception à requêtes persistantes (MPI_Recv_init/MPI_Start).
+ *
+ * Toutes les réceptions restent postées ; elles sont appariées dans l'ordre d'envoi, next() rend
+ * donc les messages dans cet ordre.
+ */
+class ReceiveChannel
+{
+public:
+    ReceiveChannel( MPI_Comm t_comm, int t_source, int t_tag, std::size_t t_max_payload, unsigned t_nb_slots = 2 );
+    ReceiveChannel( ReceiveChannel const & ) = delete;
+    ~ReceiveChannel();
+
+    ReceiveChannel& operator = ( ReceiveChannel const & ) = delete;
+
+    // Message suivant s'il est arrivé ; sa charge utile reste valide jusqu'à release(), à appeler
+    // avant de demander le message suivant
+    bool next( StepHeader& t_header, std::uint8_t const*& t_payload );
+    // Rend le tampon du message obtenu par next() et reposte sa réception
+    void release();
+
+    std::size_t messages() const { return m_messages; }
+
+private:
+    std::vector<std::vector<std::uint8_t>> m_buffers;
+    std::vector<MPI_Request> m_requests;
+    std::size_t m_next = 0;
+    std::size_t m_messages = 0;
+};
@@ -0,0 +1,85 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include "checkpoint.hpp"
+
+bool
+CheckpointHeader::valid() const
+{
+    return std::memcmp(magic, magic_string, sizeof(magic)) == 0 && version == 1 && geometry > 0;
+}
+// ====================================================================================================================
+CheckpointHeader
+checkpoint_header( Model const& t_model )
+{
+    CheckpointHeader header;
+    std::memcpy(header.magic, CheckpointHeader::magic_string, sizeof(header.magic));
+    header.geometry  = t_model.geometry();
+    header.time_step = t_model.time_step();
+    header.seed      = t_model.seed();
+    header.length    = t_model.length();
+    header.wind[0]   = t_model.wind()[0];
+    header.wind[1]   = t_model.wind()[1];
+    header.max_wind  = t_model.max_wind();
+    return header;
+}
+// --------------------------------------------------------------------------------------------------------------------
+CheckpointHeader
+read_checkpoint_header( std::string const& t_path )
+{
+    std::ifstream file(t_path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Impossible d'ouvrir le point de sauvegarde " + t_path);
+    CheckpointHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || !header.valid())
+        throw std::runtime_error("Format de point de sauvegarde inconnu : " + t_path);
+    return header;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+save_checkpoint( Model const& t_model, std::string const& t_path )
+{
+    const Model::Domain domain = t_model.domain();
+    if (domain.nb_rows != t_model.geometry() || domain.nb_columns != t_model.geometry())
+    {
+        throw std::range_error("Un point de sauvegarde sans MPI couvre la grille entière (cf. DistributedModel).");
+    }
+    // Grille entière : chaque plan est contigu, le front compris (pas d'une ligne = geometry)
+    const std::size_t nb_cells = std::size_t(domain.nb_rows)*domain.nb_columns;
+    const CheckpointHeader header = checkpoint_header(t_model);
+    const std::string temporary = t_path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file)
+            throw std::runtime_error("Impossible de créer le point de sauvegarde " + temporary);
+        file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        file.write(reinterpret_cast<char const*>(t_model.vegetal_map().data()), std::streamsize(nb_cells));
+        file.write(reinterpret_cast<char const*>(t_model.fire_map().data()), std::streamsize(nb_cells));
+        file.write(reinterpret_cast<char const*>(t_model.fire_front().data()), std::streamsize(nb_cells));
+        file.close();
+        if (!file)
+            throw std::runtime_error("Écriture impossible du point de sauvegarde " + temporary);
+    }
+    if (std::rename(temporary.c_str(), t_path.c_str()) != 0)
+        throw std::runtime_error("Impossible de renommer " + temporary + " en " + t_path);
+}
+// --------------------------------------------------------------------------------------------------------------------
+Model
+load_checkpoint( std::string const& t_path )
+{
+    const CheckpointHeader header = read_checkpoint_header(t_path);
+    const std::size_t nb_cells = std::size_t(header.geometry)*header.geometry;
+    std::vector<std::uint8_t> planes(3*nb_cells);
+    std::ifstream file(t_path, std::ios::binary);
+    file.seekg(std::streamoff(header.plane_offset(0)));
+    if (!file.read(reinterpret_cast<char*>(planes.data()), std::streamsize(planes.size())))
+        throw std::runtime_error("Point de sauvegarde incomplet : " + t_path);
+
+    // Le foyer initial est remplacé par l'état sauvegardé
+    Model model(header.length, header.geometry, {header.wind[0], header.wind[1]}, {0u, 0u}, header.max_wind, header.seed);
+    model.set_domain(model.domain(), planes.data(), planes.data() + nb_cells, planes.data() + 2*nb_cells);
+    model.set_time_step(header.time_step);
+    return model;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "model.hpp"
+
+/**
+ * @brief Point de sauvegarde de l'état d'une simulation, pour la reprendre après une interruption.
+ *
+ * Format (entiers et réels dans l'ordre des octets de la machine) :
+ *  - en-tête CheckpointHeader : paramètres du modèle (géométrie, longueur, vent, graine) et pas de temps ;
+ *  - trois plans de geometry x geometry octets, ligne par ligne sur la grille entière : végétation, feu
+ *    et intensité du front (0 hors du front).
+ * Les plans couvrent la grille globale, indépendamment du découpage : un point de sauvegarde écrit par
+ * un modèle entier ou par DistributedModel (MPI-IO) se reprend avec n'importe quel nombre de processus.
+ * Les tirages ne dépendant que de la graine, de la case et du pas, la reprise est identique, case par
+ * case, à la simulation ininterrompue. Le moteur et le nombre de threads ne sont pas sauvegardés : ils
+ * ne changent pas le résultat.
+ */
+struct CheckpointHeader
+{
+    static constexpr char magic_string[9] = "FIRECKP1";
+
+    char magic[8];
+    std::uint32_t version = 1;
+    std::uint32_t geometry = 0;
+    std::uint64_t time_step = 0;
+    std::uint64_t seed = 0;
+    double length = 0.;
+    double wind[2] = {0., 0.};
+    double max_wind = 0.;
+
+    // Position du plan t_plane (0 : végétation, 1 : feu, 2 : intensité du front) dans le fichier
+    std::uint64_t plane_offset( unsigned t_plane ) const
+    { return sizeof(CheckpointHeader) + std::uint64_t(t_plane)*geometry*geometry; }
+    bool valid() const;
+};
+
+// En-tête décrivant l'état courant de t_model
+CheckpointHeader checkpoint_header( Model const& t_model );
+// Lit et vérifie l'en-tête d'un point de sauvegarde (std::runtime_error si illisible ou de format inconnu)
+CheckpointHeader read_checkpoint_header( std::string const& t_path );
+
+// Écriture par un seul processus d'un modèle couvrant la grille entière (std::range_error sinon).
+// Le fichier est écrit sous un nom temporaire puis renommé : une panne pendant l'écriture laisse intact
+// le point de sauvegarde précédent. Les erreurs d'écriture lèvent std::runtime_error.
+void  save_checkpoint( Model const& t_model, std::string const& t_path );
+// Modèle entier reconstruit à partir d'un point de sauvegarde, prêt à reprendre au pas suivant
+Model load_checkpoint( std::string const& t_path );
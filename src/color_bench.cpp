@@ -0,0 +1,96 @@
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include "color_map.hpp"
+
+// Micro-benchmark de la conversion des cartes en pixels (débit en cases par seconde) : couleur
+// calculée case par case avec branchements (ancien rendu), lecture des palettes case par case, puis
+// noyau vectoriel sur un thread et sur tous les threads. Toutes les versions doivent donner les
+// mêmes pixels.
+
+// Ancien calcul de la couleur, branchement et calcul en double précision par case
+std::uint32_t branchy_color(std::uint8_t veg, std::uint8_t fire) {
+    std::uint32_t red = 0, green = veg;
+    if (fire > 0) {
+        red = 255;
+        green = fire > 127 ? 0 : static_cast<std::uint8_t>(255 * (1 - fire/127.0));
+    }
+    return 0xFF000000u | (red << 16) | (green << 8);
+}
+
+template<typename Kernel>
+double cells_per_second(Kernel&& kernel, std::size_t nb_cells, int nb_repeats) {
+    kernel(); // Mise en température des caches
+    auto start = std::chrono::steady_clock::now();
+    for (int repeat = 0; repeat < nb_repeats; ++repeat)
+        kernel();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return double(nb_cells) * nb_repeats / elapsed.count();
+}
+
+int main(int argc, char* argv[]) {
+    unsigned size = 2000;
+    int nb_repeats = 20;
+    double fire_ratio = 0.1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--size" && i + 1 < argc) size = std::stoul(argv[++i]);
+        else if (arg == "--repeat" && i + 1 < argc) nb_repeats = std::stoi(argv[++i]);
+        else if (arg == "--fire" && i + 1 < argc) fire_ratio = std::stod(argv[++i]);
+    }
+
+    // Cartes aléatoires : végétation quelconque, une proportion fire_ratio de cases en feu
+    const std::size_t nb_cells = std::size_t(size) * size;
+    std::vector<std::uint8_t> vegetation(nb_cells), fire(nb_cells);
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> byte(0, 255), intensity(1, 255);
+    std::bernoulli_distribution burning(fire_ratio);
+    for (std::size_t cell = 0; cell < nb_cells; ++cell) {
+        vegetation[cell] = std::uint8_t(byte(generator));
+        fire[cell] = burning(generator) ? std::uint8_t(intensity(generator)) : 0;
+    }
+
+    ColorMap colors;
+    const unsigned max_threads = colors.threads();
+    std::vector<std::uint32_t> reference(nb_cells), pixels(nb_cells);
+    const std::size_t pitch = std::size_t(size) * sizeof(std::uint32_t);
+
+    std::pair<char const*, double> results[4];
+    results[0] = {"branchements        ", cells_per_second([&] {
+        for (std::size_t cell = 0; cell < nb_cells; ++cell)
+            reference[cell] = branchy_color(vegetation[cell], fire[cell]);
+    }, nb_cells, nb_repeats)};
+    results[1] = {"palettes (scalaire) ", cells_per_second([&] {
+        for (std::size_t cell = 0; cell < nb_cells; ++cell)
+            pixels[cell] = colors.color(vegetation[cell], fire[cell]);
+    }, nb_cells, nb_repeats)};
+    bool identical = pixels == reference;
+    colors.set_threads(1);
+    results[2] = {"noyau, 1 thread     ", cells_per_second([&] {
+        colors.convert(vegetation.data(), fire.data(), size, size, size, pixels.data(), pitch);
+    }, nb_cells, nb_repeats)};
+    identical = identical && pixels == reference;
+    colors.set_threads(max_threads);
+    results[3] = {"noyau, tous threads ", cells_per_second([&] {
+        colors.convert(vegetation.data(), fire.data(), size, size, size, pixels.data(), pitch);
+    }, nb_cells, nb_repeats)};
+    identical = identical && pixels == reference;
+
+    std::cout << "Conversion des cartes en pixels : " << size << " x " << size << " cases, "
+              << 100 * fire_ratio << " % en feu, " << max_threads << " threads au plus" << std::endl;
+#if defined(__AVX2__)
+    std::cout << "Noyau vectoriel : AVX2" << std::endl;
+#else
+    std::cout << "Noyau vectoriel : non disponible (compilation sans AVX2), version scalaire" << std::endl;
+#endif
+    std::cout << "version               Mcases/s   accélération" << std::endl;
+    for (auto const& [name, rate] : results)
+        std::cout << name << "  " << std::setw(9) << std::fixed << std::setprecision(1) << rate / 1e6
+                  << "   x" << std::setprecision(2) << rate / results[0].second << std::endl;
+    std::cout << (identical ? "Pixels identiques dans toutes les versions." : "[ERREUR] Pixels différents !") << std::endl;
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#include <algorithm>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "color_map.hpp"
+
+namespace
+{
+    constexpr std::uint32_t argb( std::uint32_t t_red, std::uint32_t t_green, std::uint32_t t_blue )
+    {
+        return 0xFF000000u | (t_red << 16) | (t_green << 8) | t_blue;
+    }
+}
+
+ColorMap::ColorMap()
+    :
+#if defined(_OPENMP)
+        m_nb_threads(unsigned(omp_get_max_threads()))
+#else
+        m_nb_threads(1)
+#endif
+{
+    // Végétation en vert, plus clair quand la densité est plus élevée
+    for (unsigned value = 0; value < 256; ++value)
+        m_vegetation_palette[value] = argb(0, value, 0);
+    // Feu : rouge vif pour le feu intense, puis orange -> jaune quand il s'éteint
+    m_fire_palette[0] = argb(0, 0, 0);
+    for (unsigned value = 1; value < 256; ++value)
+        m_fire_palette[value] = value > 127 ? argb(255, 0, 0)
+                                            : argb(255, std::uint8_t(255 * (1 - value/127.0)), 0);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+ColorMap::convert_row( std::uint8_t const* t_vegetation, std::uint8_t const* t_fire, unsigned t_width,
+                       std::uint32_t* t_pixels ) const
+{
+    unsigned column = 0;
+#if defined(__AVX2__)
+    // Huit cases par paquet : lecture des deux palettes, puis choix de la couleur selon le feu
+    int const* vegetation_palette = reinterpret_cast<int const*>(m_vegetation_palette.data());
+    int const* fire_palette = reinterpret_cast<int const*>(m_fire_palette.data());
+    const __m256i zero = _mm256_setzero_si256();
+    for (; column + 8 <= t_width; column += 8)
+    {
+        __m256i vegetation = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(t_vegetation + column)));
+        __m256i fire       = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(t_fire + column)));
+        __m256i green = _mm256_i32gather_epi32(vegetation_palette, vegetation, 4);
+        __m256i flame = _mm256_i32gather_epi32(fire_palette, fire, 4);
+        __m256i pixels = _mm256_blendv_epi8(flame, green, _mm256_cmpeq_epi32(fire, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(t_pixels + column), pixels);
+    }
+#endif
+    for (; column < t_width; ++column)
+        t_pixels[column] = color(t_vegetation[column], t_fire[column]);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+ColorMap::convert( std::uint8_t const* t_vegetation, std::uint8_t const* t_fire, unsigned t_width, unsigned t_height,
+                   std::size_t t_stride, void* t_pixels, std::size_t t_pitch ) const
+{
+    const std::size_t nb_cells = std::size_t(t_width)*t_height;
+    const int nb_threads = int(std::max<std::size_t>(1, std::min<std::size_t>(m_nb_threads, nb_cells/min_cells_per_thread)));
+    std::uint8_t* pixels = static_cast<std::uint8_t*>(t_pixels);
+#pragma omp parallel for num_threads(nb_threads) schedule(static) if(nb_threads > 1)
+    for (int row = 0; row < int(t_height); ++row)
+    {
+        std::size_t offset = std::size_t(row)*t_stride;
+        convert_row(t_vegetation + offset, t_fire + offset, t_width,
+                    reinterpret_cast<std::uint32_t*>(pixels + std::size_t(row)*t_pitch));
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Conversion des cartes (végétation, feu) en pixels ARGB8888 par tables de couleurs.
+ *
+ * Une case en feu prend la couleur de son intensité dans la palette du feu, une case éteinte celle
+ * de sa densité dans la palette de la végétation. Les deux palettes de 256 entrées sont calculées
+ * une fois ; la conversion ne fait plus qu'une lecture de table par case, sans branchement, par
+ * paquets de huit cases en AVX2. Les lignes sont réparties entre threads OpenMP pour les grandes
+ * cartes.
+ */
+class ColorMap
+{
+public:
+    ColorMap();
+
+    // Couleur d'une case (référence scalaire du noyau vectoriel)
+    std::uint32_t color( std::uint8_t t_vegetation, std::uint8_t t_fire ) const
+    { return t_fire ? m_fire_palette[t_fire] : m_vegetation_palette[t_vegetation]; }
+
+    // Cartes de t_height lignes de t_width cases, espacées de t_stride cases, vers t_height lignes de
+    // pixels espacées de t_pitch octets
+    void convert( std::uint8_t const* t_vegetation, std::uint8_t const* t_fire, unsigned t_width, unsigned t_height,
+                  std::size_t t_stride, void* t_pixels, std::size_t t_pitch ) const;
+    // Une ligne de t_width cases
+    void convert_row( std::uint8_t const* t_vegetation, std::uint8_t const* t_fire, unsigned t_width,
+                      std::uint32_t* t_pixels ) const;
+
+    // Nombre maximal de threads de convert() ; en dessous de min_cells_per_thread cases par thread,
+    // la conversion reste séquentielle
+    static constexpr std::size_t min_cells_per_thread = 1u << 16;
+    void     set_threads( unsigned t_nb_threads ) { m_nb_threads = t_nb_threads > 0 ? t_nb_threads : 1; }
+    unsigned threads() const { return m_nb_threads; }
+
+private:
+    std::array<std::uint32_t,256> m_vegetation_palette, m_fire_palette;
+    unsigned m_nb_threads;
+};
@@ -0,0 +1,67 @@
+#include "counter_rng.hpp"
+
+void
+CounterRng::fill( std::uint32_t t_first_cell, std::size_t t_count, std::uint32_t t_step, std::uint32_t t_stream,
+                  std::array<std::uint32_t*,4> const& t_words ) const
+{
+    std::size_t k = 0;
+#if defined(__AVX2__)
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    for (; k + 8 <= t_count; k += 8)
+    {
+        __m256i block[4];
+        generate(_mm256_add_epi32(_mm256_set1_epi32(int(t_first_cell + k)), lanes), t_step, t_stream, block);
+        for (int w = 0; w < 4; ++w)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(t_words[w] + k), block[w]);
+    }
+#endif
+    for (; k < t_count; ++k)
+    {
+        Block block = (*this)(std::uint32_t(t_first_cell + k), t_step, t_stream);
+        for (int w = 0; w < 4; ++w) t_words[w][k] = block[w];
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+CounterRng::fill( std::uint32_t const* t_cells, std::size_t t_count, std::uint32_t t_step, std::uint32_t t_stream,
+                  std::array<std::uint32_t*,4> const& t_words ) const
+{
+    std::size_t k = 0;
+#if defined(__AVX2__)
+    for (; k + 8 <= t_count; k += 8)
+    {
+        __m256i block[4];
+        generate(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(t_cells + k)), t_step, t_stream, block);
+        for (int w = 0; w < 4; ++w)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(t_words[w] + k), block[w]);
+    }
+#endif
+    for (; k < t_count; ++k)
+    {
+        Block block = (*this)(t_cells[k], t_step, t_stream);
+        for (int w = 0; w < 4; ++w) t_words[w][k] = block[w];
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+CounterRng::fill_seeds( std::uint32_t const* t_keys_low, std::uint32_t const* t_keys_high, std::size_t t_count,
+                        std::uint32_t t_cell, std::uint32_t t_step, std::uint32_t t_stream,
+                        std::array<std::uint32_t*,4> const& t_words )
+{
+    std::size_t k = 0;
+#if defined(__AVX2__)
+    for (; k + 8 <= t_count; k += 8)
+    {
+        __m256i block[4];
+        generate_seeds(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(t_keys_low + k)),
+                       _mm256_loadu_si256(reinterpret_cast<__m256i const*>(t_keys_high + k)), t_cell, t_step, t_stream, block);
+        for (int w = 0; w < 4; ++w)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(t_words[w] + k), block[w]);
+    }
+#endif
+    for (; k < t_count; ++k)
+    {
+        Block block = CounterRng(std::uint64_t(t_keys_high[k]) << 32 | t_keys_low[k])(t_cell, t_step, t_stream);
+        for (int w = 0; w < 4; ++w) t_words[w][k] = block[w];
+    }
+}
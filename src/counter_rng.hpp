@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Générateur pseudo-aléatoire à compteur (Philox4x32-10).
+ *
+ * Un tirage est une fonction pure de (graine, case, pas de temps, flux) : il ne dépend ni de
+ * l'ordre de parcours des cases, ni du nombre de threads ou de processus qui les calculent.
+ * Chaque appel produit un bloc de quatre mots de 32 bits indépendants.
+ */
+class CounterRng
+{
+public:
+    using Block = std::array<std::uint32_t,4>;
+
+    explicit CounterRng( std::uint64_t t_seed = 0 )
+        :   m_key{std::uint32_t(t_seed), std::uint32_t(t_seed >> 32)}
+    {}
+
+    std::uint64_t seed() const { return std::uint64_t(m_key[1]) << 32 | m_key[0]; }
+
+    Block operator () ( std::uint32_t t_cell, std::uint32_t t_step, std::uint32_t t_stream ) const
+    {
+        std::uint32_t c0 = t_cell, c1 = t_step, c2 = t_stream, c3 = 0;
+        std::uint32_t k0 = m_key[0], k1 = m_key[1];
+        for (int round = 0; round < nb_rounds; ++round)
+        {
+            std::uint64_t p0 = std::uint64_t(multiplier0)*c0;
+            std::uint64_t p1 = std::uint64_t(multiplier1)*c2;
+            std::uint32_t n0 = std::uint32_t(p1 >> 32) ^ c1 ^ k0;
+            std::uint32_t n2 = std::uint32_t(p0 >> 32) ^ c3 ^ k1;
+            c1 = std::uint32_t(p1); c3 = std::uint32_t(p0);
+            c0 = n0; c2 = n2;
+            k0 += weyl0; k1 += weyl1;
+        }
+        return {c0, c1, c2, c3};
+    }
+
+    // Tirages en lot, rangés mot par mot : t_words[w][k] est le mot w du bloc de la k-ième case.
+    // Cases consécutives à partir de t_first_cell :
+    void fill( std::uint32_t t_first_cell, std::size_t t_count, std::uint32_t t_step, std::uint32_t t_stream,
+               std::array<std::uint32_t*,4> const& t_words ) const;
+    // Cases quelconques :
+    void fill( std::uint32_t const* t_cells, std::size_t t_count, std::uint32_t t_step, std::uint32_t t_stream,
+               std::array<std::uint32_t*,4> const& t_words ) const;
+    // Même case pour t_count graines (clé k : {t_keys_low[k], t_keys_high[k]}, cf. key()) : t_words[w][k] est le
+    // mot w du bloc de la k-ième graine. Les blocs sont calculés par huit (AVX2).
+    static void fill_seeds( std::uint32_t const* t_keys_low, std::uint32_t const* t_keys_high, std::size_t t_count,
+                            std::uint32_t t_cell, std::uint32_t t_step, std::uint32_t t_stream,
+                            std::array<std::uint32_t*,4> const& t_words );
+    std::array<std::uint32_t,2> key() const { return {m_key[0], m_key[1]}; }
+
+#if defined(__AVX2__)
+    // Huit blocs calculés en registres, un par voie de t_cells
+    void generate( __m256i t_cells, std::uint32_t t_step, std::uint32_t t_stream, __m256i (&t_out)[4] ) const
+    {
+        __m256i c0 = t_cells, c1 = _mm256_set1_epi32(int(t_step));
+        __m256i c2 = _mm256_set1_epi32(int(t_stream)), c3 = _mm256_setzero_si256();
+        const __m256i m0 = _mm256_set1_epi32(int(multiplier0)), m1 = _mm256_set1_epi32(int(multiplier1));
+        std::uint32_t k0 = m_key[0], k1 = m_key[1];
+        for (int round = 0; round < nb_rounds; ++round)
+        {
+            __m256i hi0, lo0, hi1, lo1;
+            mulhilo(c0, m0, hi0, lo0);
+            mulhilo(c2, m1, hi1, lo1);
+            c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(int(k0)));
+            c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(int(k1)));
+            c1 = lo1; c3 = lo0;
+            k0 += weyl0; k1 += weyl1;
+        }
+        t_out[0] = c0; t_out[1] = c1; t_out[2] = c2; t_out[3] = c3;
+    }
+    // Huit blocs d'une même case, un par voie de clés {t_keys_low, t_keys_high}
+    static void generate_seeds( __m256i t_keys_low, __m256i t_keys_high, std::uint32_t t_cell, std::uint32_t t_step,
+                                std::uint32_t t_stream, __m256i (&t_out)[4] )
+    {
+        __m256i c0 = _mm256_set1_epi32(int(t_cell)), c1 = _mm256_set1_epi32(int(t_step));
+        __m256i c2 = _mm256_set1_epi32(int(t_stream)), c3 = _mm256_setzero_si256();
+        const __m256i m0 = _mm256_set1_epi32(int(multiplier0)), m1 = _mm256_set1_epi32(int(multiplier1));
+        const __m256i w0 = _mm256_set1_epi32(int(weyl0)), w1 = _mm256_set1_epi32(int(weyl1));
+        __m256i k0 = t_keys_low, k1 = t_keys_high;
+        for (int round = 0; round < nb_rounds; ++round)
+        {
+            __m256i hi0, lo0, hi1, lo1;
+            mulhilo(c0, m0, hi0, lo0);
+            mulhilo(c2, m1, hi1, lo1);
+            c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), k0);
+            c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), k1);
+            c1 = lo1; c3 = lo0;
+            k0 = _mm256_add_epi32(k0, w0); k1 = _mm256_add_epi32(k1, w1);
+        }
+        t_out[0] = c0; t_out[1] = c1; t_out[2] = c2; t_out[3] = c3;
+    }
+#endif
+
+private:
+    static constexpr int           nb_rounds   = 10;
+    static constexpr std::uint32_t multiplier0 = 0xD2511F53u, multiplier1 = 0xCD9E8D57u;
+    static constexpr std::uint32_t weyl0       = 0x9E3779B9u, weyl1       = 0xBB67AE85u;
+
+#if defined(__AVX2__)
+    // Produit 32x32 -> 64 bits voie par voie : _mm256_mul_epu32 ne traite que les voies paires
+    static void mulhilo( __m256i t_a, __m256i t_b, __m256i& t_hi, __m256i& t_lo )
+    {
+        __m256i even = _mm256_mul_epu32(t_a, t_b);
+        __m256i odd  = _mm256_mul_epu32(_mm256_srli_epi64(t_a, 32), t_b);
+        t_lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+        t_hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    }
+#endif
+
+    std::uint32_t m_key[2];
+};
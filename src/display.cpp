@@ -4,6 +4,7 @@
 #include "display.hpp"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 using namespace std::string_literals;
 
@@ -38,6 +39,10 @@ Displayer::Displayer(int width, int height)
     }
 
     m_pt_renderer = SDL_CreateRenderer(m_window, -1, SDL_RENDERER_ACCELERATED);
+    if (!m_pt_renderer) {
+        // Sans accélération matérielle, le renderer logiciel met la texture à l'échelle de la fenêtre
+        m_pt_renderer = SDL_CreateRenderer(m_window, -1, SDL_RENDERER_SOFTWARE);
+    }
     if (!m_pt_renderer) {
         std::cout << "Renderer creation failed: " << SDL_GetError() << std::endl;
         return;
@@ -46,23 +51,136 @@ Displayer::Displayer(int width, int height)
 
 Displayer::~Displayer()
 {
+    if (m_texture) SDL_DestroyTexture(m_texture);
     if (m_pt_renderer) SDL_DestroyRenderer(m_pt_renderer);
     if (m_window) SDL_DestroyWindow(m_window);
     SDL_Quit();
 }
 
-void Displayer::update(const std::vector<std::uint8_t>& vegetation_global_map, const std::vector<std::uint8_t>& fire_global_map)
+void Displayer::update(MapView vegetation_global_map, MapView fire_global_map)
 {
     int grid_size = static_cast<int>(std::sqrt(vegetation_global_map.size()));
-    double cell_w = static_cast<double>(m_width) / grid_size;
-    double cell_h = static_cast<double>(m_height) / grid_size;
+    if (grid_size != m_grid_size) {
+        m_grid_size = grid_size;
+        reset_view();
+    }
+
+    // Région visible, puis niveau de la pyramide qui la ramène à la taille de la fenêtre :
+    // seules les cases visibles sont lues, et chaque pixel résume les cases qu'il couvre
+    int side = std::max(1, static_cast<int>(std::lround(grid_size / m_zoom)));
+    int first_column = std::clamp(static_cast<int>(std::lround(m_view_x)), 0, grid_size - side);
+    int first_row = std::clamp(static_cast<int>(std::lround(m_view_y)), 0, grid_size - side);
+    std::size_t offset = std::size_t(first_row) * grid_size + first_column;
+    MapPyramid::Level region{vegetation_global_map.data() + offset, fire_global_map.data() + offset,
+                             unsigned(side), unsigned(side), std::size_t(grid_size)};
+    unsigned level = MapPyramid::level_for(side, side, m_width, m_height);
+    MapPyramid::Level reduced = m_pyramid.reduce(region, level);
+
+    if (m_mode == Mode::texture)
+        draw_texture(reduced);
+    else
+        draw_rectangles(reduced);
+    SDL_RenderPresent(m_pt_renderer);
+}
+
+void Displayer::reset_view()
+{
+    m_zoom = 1.;
+    m_view_x = m_view_y = 0.;
+}
+
+void Displayer::zoom(double factor, double x, double y)
+{
+    if (m_grid_size == 0) return;
+    // Au plus fort grossissement, 16 cases restent visibles
+    double max_zoom = std::max(1., m_grid_size / 16.);
+    double side = m_grid_size / m_zoom;
+    double cell_x = m_view_x + x / m_width * side, cell_y = m_view_y + y / m_height * side;
+    m_zoom = std::clamp(m_zoom * factor, 1., max_zoom);
+    side = m_grid_size / m_zoom;
+    m_view_x = std::clamp(cell_x - x / m_width * side, 0., m_grid_size - side);
+    m_view_y = std::clamp(cell_y - y / m_height * side, 0., m_grid_size - side);
+}
+
+bool Displayer::handle_event(SDL_Event const& event)
+{
+    double old_zoom = m_zoom, old_x = m_view_x, old_y = m_view_y;
+    double side = m_grid_size / m_zoom;
+    auto pan = [&](double dx, double dy) {
+        m_view_x = std::clamp(m_view_x + dx, 0., m_grid_size - side);
+        m_view_y = std::clamp(m_view_y + dy, 0., m_grid_size - side);
+    };
+    switch (event.type) {
+    case SDL_MOUSEWHEEL:
+        zoom(std::pow(1.25, event.wheel.y), m_mouse_x, m_mouse_y);
+        break;
+    case SDL_MOUSEMOTION:
+        m_mouse_x = event.motion.x;
+        m_mouse_y = event.motion.y;
+        if (event.motion.state & SDL_BUTTON_LMASK)
+            pan(-event.motion.xrel * side / m_width, -event.motion.yrel * side / m_height);
+        break;
+    case SDL_KEYDOWN:
+        switch (event.key.keysym.sym) {
+        case SDLK_PLUS: case SDLK_KP_PLUS: case SDLK_EQUALS: zoom(1.25, m_width / 2., m_height / 2.); break;
+        case SDLK_MINUS: case SDLK_KP_MINUS:                 zoom(0.8, m_width / 2., m_height / 2.); break;
+        case SDLK_LEFT:  pan(-side / 10, 0.); break;
+        case SDLK_RIGHT: pan( side / 10, 0.); break;
+        case SDLK_UP:    pan(0., -side / 10); break;
+        case SDLK_DOWN:  pan(0.,  side / 10); break;
+        case SDLK_r:     reset_view(); break;
+        default: break;
+        }
+        break;
+    default:
+        break;
+    }
+    return m_zoom != old_zoom || m_view_x != old_x || m_view_y != old_y;
+}
+
+void Displayer::draw_texture(MapPyramid::Level level)
+{
+    int width = static_cast<int>(level.width), height = static_cast<int>(level.height);
+    if (width != m_texture_width || height != m_texture_height) {
+        if (m_texture) SDL_DestroyTexture(m_texture);
+        m_texture = SDL_CreateTexture(m_pt_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                      width, height);
+        if (!m_texture) {
+            std::cout << "Texture creation failed: " << SDL_GetError() << std::endl;
+            m_mode = Mode::rectangles;
+            m_texture_width = m_texture_height = 0;
+            draw_rectangles(level);
+            return;
+        }
+        m_texture_width = width;
+        m_texture_height = height;
+    }
+
+    // Un seul verrouillage par image : les pixels sont écrits directement dans la texture
+    void* pixels;
+    int pitch;
+    if (SDL_LockTexture(m_texture, nullptr, &pixels, &pitch) < 0) {
+        std::cout << "Texture lock failed: " << SDL_GetError() << std::endl;
+        return;
+    }
+    m_colors.convert(level.vegetation, level.fire, level.width, level.height, level.stride, pixels, pitch);
+    SDL_UnlockTexture(m_texture);
+
+    // Mise à l'échelle de la fenêtre par le renderer (sans interpolation, cf. SDL_HINT_RENDER_SCALE_QUALITY)
+    SDL_RenderCopy(m_pt_renderer, m_texture, nullptr, nullptr);
+}
+
+void Displayer::draw_rectangles(MapPyramid::Level level)
+{
+    double cell_w = static_cast<double>(m_width) / level.width;
+    double cell_h = static_cast<double>(m_height) / level.height;
 
     SDL_SetRenderDrawColor(m_pt_renderer, 0, 0, 0, 255);
     SDL_RenderClear(m_pt_renderer);
 
-    for (int i = 0; i < grid_size; ++i) {
-        for (int j = 0; j < grid_size; ++j) {
-            int index = i * grid_size + j;
+    for (int i = 0; i < int(level.height); ++i) {
+        for (int j = 0; j < int(level.width); ++j) {
+            std::size_t index = i * level.stride + j;
             SDL_Rect rect = {
                 static_cast<int>(j * cell_w),
                 static_cast<int>(i * cell_h),
@@ -70,8 +188,8 @@ void Displayer::update(const std::vector<std::uint8_t>& vegetation_global_map, c
                 static_cast<int>(std::ceil(cell_h))   // pour éviter les trous
             };
 
-            uint8_t fire = fire_global_map[index];
-            uint8_t veg = vegetation_global_map[index];
+            uint8_t fire = level.fire[index];
+            uint8_t veg = level.vegetation[index];
 
             if (fire > 0) {
                 // Gradient de couleur pour le feu : rouge -> orange -> jaune
@@ -93,6 +211,4 @@ void Displayer::update(const std::vector<std::uint8_t>& vegetation_global_map, c
             SDL_RenderFillRect(m_pt_renderer, &rect);
         }
     }
-
-    SDL_RenderPresent(m_pt_renderer);
 }
@@ -5,22 +5,55 @@
 #include <memory>
 #include <vector>
 #include <cstdint>
+#include "map_view.hpp"
+#include "color_map.hpp"
+#include "map_pyramid.hpp"
 
 class Displayer
 {
 public:
+    // Rendu d'une image : un rectangle par case (un appel au renderer par case), ou une texture
+    // d'un pixel par case, remplie en mémoire puis mise à l'échelle de la fenêtre en une seule copie
+    enum class Mode { rectangles, texture };
+
+    // Taille de fenêtre au-delà de laquelle les grandes grilles sont réduites (niveaux de détail)
+    static constexpr int max_window_size = 1024;
+    // Côté de fenêtre pour une grille de grid_size cases, à scale pixels par case au plus
+    static int window_size(int grid_size, int scale) { return grid_size * scale < max_window_size ? grid_size * scale : max_window_size; }
+
     static std::shared_ptr<Displayer> createOrGetInstance(int width, int height);
     ~Displayer();
-    void update(const std::vector<std::uint8_t>& vegetation_global_map, const std::vector<std::uint8_t>& fire_global_map);
+    void update(MapView vegetation_global_map, MapView fire_global_map);
+    void set_mode(Mode mode) { m_mode = mode; }
+    Mode mode() const { return m_mode; }
+
+    // Vue : molette ou +/- pour zoomer, glisser (bouton gauche) ou flèches pour se déplacer, r pour
+    // revenir à la grille entière. Renvoie vrai si la vue a changé (l'image est alors à redessiner).
+    bool handle_event(SDL_Event const& event);
+    void reset_view();
 
 private:
     Displayer(int width, int height);
     static std::shared_ptr<Displayer> unique_instance;
+
+    void draw_rectangles(MapPyramid::Level level);
+    void draw_texture(MapPyramid::Level level);
+    // Zoom d'un facteur factor autour du point (x, y) de la fenêtre, qui reste fixe
+    void zoom(double factor, double x, double y);
     
     int m_width;
     int m_height;
     SDL_Window* m_window;
     SDL_Renderer* m_pt_renderer;
+    Mode m_mode = Mode::texture;
+    SDL_Texture* m_texture = nullptr; // Texture persistante (streaming), recréée si la région affichée change de taille
+    int m_texture_width = 0, m_texture_height = 0;
+    ColorMap m_colors;                // Palettes et conversion des cartes en pixels de la texture
+    MapPyramid m_pyramid;             // Réduction de la région affichée à la résolution de la fenêtre
+    // Région affichée : coin haut gauche en cases et grossissement (la grille entière tant que m_zoom vaut 1)
+    int m_grid_size = 0;
+    double m_zoom = 1., m_view_x = 0., m_view_y = 0.;
+    int m_mouse_x = 0, m_mouse_y = 0;
 };
 
 #endif
@@ -0,0 +1,45 @@
+#include "display_sink.hpp"
+
+DisplaySink::DisplaySink( int t_window_size, Displayer::Mode t_mode, double t_fps )
+    :   m_displayer(Displayer::createOrGetInstance(t_window_size, t_window_size)),
+        m_period(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0/t_fps))),
+        m_next_display(std::chrono::steady_clock::now())
+{
+    m_displayer->set_mode(t_mode);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+DisplaySink::write( std::uint64_t, MapView t_vegetation, MapView t_fire, bool t_last )
+{
+    m_vegetation = t_vegetation;
+    m_fire = t_fire;
+    m_pending = true;
+    if (t_last || std::chrono::steady_clock::now() >= m_next_display)
+        draw();
+}
+// --------------------------------------------------------------------------------------------------------------------
+bool
+DisplaySink::poll()
+{
+    SDL_Event event;
+    while (SDL_PollEvent(&event))
+    {
+        if (event.type == SDL_QUIT)
+            m_closed = true;
+        else if (m_displayer->handle_event(event) && !m_vegetation.empty())
+            m_pending = true;
+    }
+    if (m_pending && std::chrono::steady_clock::now() >= m_next_display)
+        draw();
+    return m_closed;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+DisplaySink::draw()
+{
+    if (m_closed) return;
+    m_displayer->update(m_vegetation, m_fire);
+    m_pending = false;
+    m_displayed += 1;
+    m_next_display = std::chrono::steady_clock::now() + m_period;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include "frame_sink.hpp"
+#include "display.hpp"
+
+/**
+ * @brief Affichage SDL des trames, à une cadence bornée.
+ *
+ * Les trames arrivent au rythme du calcul ; seule la plus récente est dessinée, au plus t_fps fois par
+ * seconde (la dernière trame l'est toujours). poll() traite les événements de la fenêtre : une
+ * nouvelle vue (zoom, déplacement) redessine la dernière trame, la fermeture demande l'arrêt du calcul,
+ * après quoi plus rien n'est dessiné. Les cartes reçues par write() doivent rester valides jusqu'à la
+ * trame suivante.
+ */
+class DisplaySink : public FrameSink
+{
+public:
+    DisplaySink( int t_window_size, Displayer::Mode t_mode, double t_fps );
+
+    void write( std::uint64_t t_step, MapView t_vegetation, MapView t_fire, bool t_last ) override;
+    bool poll() override;
+    std::size_t written() const override { return m_displayed; }
+
+private:
+    void draw();
+
+    std::shared_ptr<Displayer> m_displayer;
+    std::chrono::steady_clock::duration m_period;
+    std::chrono::steady_clock::time_point m_next_display;
+    MapView m_vegetation, m_fire;  // Dernière trame reçue
+    bool m_pending = false;        // Dernière trame (ou nouvelle vue) pas encore dessinée
+    bool m_closed = false;
+    std::size_t m_displayed = 0;
+};
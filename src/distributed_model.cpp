@@ -0,0 +1,472 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include "distributed_model.hpp"
+#include "checkpoint.hpp"
+
+namespace
+{
+    MPI_Comm cartesian( MPI_Comm t_comm, std::array<int,2> t_dims )
+    {
+        MPI_Comm comm;
+        const int periods[2] = {0, 0};
+        MPI_Cart_create(t_comm, 2, t_dims.data(), periods, 1, &comm);
+        return comm;
+    }
+
+    int comm_size( MPI_Comm t_comm )
+    {
+        int size;
+        MPI_Comm_size(t_comm, &size);
+        return size;
+    }
+
+    std::array<int,2> cart_coords( MPI_Comm t_comm, int t_rank )
+    {
+        std::array<int,2> coords;
+        MPI_Cart_coords(t_comm, t_rank, 2, coords.data());
+        return coords;
+    }
+
+    std::array<int,2> cart_coords( MPI_Comm t_comm )
+    {
+        int rank;
+        MPI_Comm_rank(t_comm, &rank);
+        return cart_coords(t_comm, rank);
+    }
+
+    int neighbour( MPI_Comm t_comm, int t_dimension, int t_displacement )
+    {
+        int source, destination;
+        MPI_Cart_shift(t_comm, t_dimension, t_displacement, &source, &destination);
+        return destination;
+    }
+
+    // Part t_part parmi t_nb_parts d'un intervalle de t_length éléments : {début, longueur}
+    std::array<unsigned,2> split( unsigned t_length, int t_part, int t_nb_parts )
+    {
+        unsigned part = unsigned(t_part), nb_parts = unsigned(t_nb_parts);
+        unsigned size = t_length/nb_parts, remainder = t_length%nb_parts;
+        return {part*size + std::min(part, remainder), size + (part < remainder ? 1u : 0u)};
+    }
+
+    // Frontières des t_nb_parts parts d'un intervalle de t_length éléments découpé par split(),
+    // par unités de t_granularity éléments (la dernière unité peut être incomplète)
+    std::vector<unsigned> split_bounds( unsigned t_length, int t_nb_parts, unsigned t_granularity = 1 )
+    {
+        const unsigned nb_units = (t_length + t_granularity - 1)/t_granularity;
+        std::vector<unsigned> bounds(std::size_t(t_nb_parts) + 1, t_length);
+        for (int part = 0; part < t_nb_parts; ++part)
+            bounds[part] = std::min(split(nb_units, part, t_nb_parts)[0]*t_granularity, t_length);
+        return bounds;
+    }
+
+    // Frontières de parts de poids à peu près égaux, d'au moins un élément chacune.
+    // Sans aucun poids, les frontières t_current sont conservées.
+    std::vector<unsigned> balanced_bounds( std::vector<unsigned> const& t_weights, std::vector<unsigned> const& t_current )
+    {
+        const unsigned length = unsigned(t_weights.size()), nb_parts = unsigned(t_current.size() - 1);
+        std::vector<std::uint64_t> prefix(length + 1, 0);
+        for (unsigned i = 0; i < length; ++i)
+            prefix[i+1] = prefix[i] + t_weights[i];
+        const std::uint64_t total = prefix[length];
+        if (total == 0) return t_current;
+
+        std::vector<unsigned> bounds(nb_parts + 1, length);
+        bounds[0] = 0;
+        for (unsigned part = 1; part < nb_parts; ++part)
+        {
+            std::uint64_t target = total*part/nb_parts;
+            unsigned bound = unsigned(std::lower_bound(prefix.begin(), prefix.end(), target) - prefix.begin());
+            bounds[part] = std::clamp(bound, bounds[part-1] + 1, length - (nb_parts - part));
+        }
+        return bounds;
+    }
+
+    // Idem par unités de t_granularity éléments : les frontières restent multiples de t_granularity
+    std::vector<unsigned> balanced_bounds( std::vector<unsigned> const& t_weights, std::vector<unsigned> const& t_current,
+                                           unsigned t_granularity )
+    {
+        if (t_granularity == 1) return balanced_bounds(t_weights, t_current);
+        const unsigned length = unsigned(t_weights.size());
+        std::vector<unsigned> unit_weights((length + t_granularity - 1)/t_granularity, 0u), unit_current;
+        for (unsigned i = 0; i < length; ++i)
+            unit_weights[i/t_granularity] += t_weights[i];
+        for (auto bound : t_current)
+            unit_current.push_back((bound + t_granularity - 1)/t_granularity);
+        std::vector<unsigned> bounds = balanced_bounds(unit_weights, unit_current);
+        for (auto& bound : bounds)
+            bound = std::min(bound*t_granularity, length);
+        return bounds;
+    }
+
+    // Plus grande granularité, parmi t_granularity, t_granularity/2, ..., 1, qui laisse au moins une
+    // unité à chaque ligne et à chaque colonne de processus
+    unsigned block_granularity( unsigned t_discretization, std::array<int,2> t_dims, unsigned t_granularity )
+    {
+        const unsigned nb_parts = unsigned(std::max(t_dims[0], t_dims[1]));
+        unsigned granularity = std::max(t_granularity, 1u);
+        while (granularity > 1 && (t_discretization + granularity - 1)/granularity < nb_parts)
+            granularity /= 2;
+        return granularity;
+    }
+
+    // Bloc de la ligne de processus t_coords[0] et de la colonne de processus t_coords[1]
+    Model::Domain bounded_block( std::array<int,2> t_coords, std::vector<unsigned> const& t_row_bounds,
+                                 std::vector<unsigned> const& t_column_bounds )
+    {
+        unsigned first_row = t_row_bounds[t_coords[0]], first_column = t_column_bounds[t_coords[1]];
+        return {first_row, t_row_bounds[t_coords[0]+1] - first_row,
+                first_column, t_column_bounds[t_coords[1]+1] - first_column};
+    }
+
+    // Intersection de deux blocs (nb_rows et nb_columns nuls si elle est vide)
+    Model::Domain intersection( Model::Domain t_a, Model::Domain t_b )
+    {
+        unsigned first_row    = std::max(t_a.first_row, t_b.first_row);
+        unsigned first_column = std::max(t_a.first_column, t_b.first_column);
+        unsigned end_row    = std::min(t_a.first_row + t_a.nb_rows, t_b.first_row + t_b.nb_rows);
+        unsigned end_column = std::min(t_a.first_column + t_a.nb_columns, t_b.first_column + t_b.nb_columns);
+        if (end_row <= first_row || end_column <= first_column) return {first_row, 0u, first_column, 0u};
+        return {first_row, end_row - first_row, first_column, end_column - first_column};
+    }
+
+    // Sous-tableau du bloc t_block dans un plan de t_geometry x t_geometry octets (vue MPI-IO)
+    MPI_Datatype plane_block( Model::Domain t_block, unsigned t_geometry )
+    {
+        int sizes[2]    = {int(t_geometry), int(t_geometry)};
+        int subsizes[2] = {int(t_block.nb_rows), int(t_block.nb_columns)};
+        int starts[2]   = {int(t_block.first_row), int(t_block.first_column)};
+        MPI_Datatype block;
+        MPI_Type_create_subarray(2, sizes, subsizes, starts, MPI_ORDER_C, MPI_UINT8_T, &block);
+        MPI_Type_commit(&block);
+        return block;
+    }
+
+    // Vrai si l'opération a réussi sur tous les processus
+    bool all_succeeded( MPI_Comm t_comm, bool t_success )
+    {
+        int success = t_success ? 1 : 0;
+        MPI_Allreduce(MPI_IN_PLACE, &success, 1, MPI_INT, MPI_LAND, t_comm);
+        return success != 0;
+    }
+
+    // Lève std::runtime_error sur tous les processus si l'un d'eux a échoué
+    void check_all( MPI_Comm t_comm, bool t_success, std::string const& t_message )
+    {
+        if (!all_succeeded(t_comm, t_success)) throw std::runtime_error(t_message);
+    }
+
+    constexpr int tag_to_north = 10, tag_to_south = 11, tag_to_west = 12, tag_to_east = 13;
+}
+
+DistributedModel::DistributedModel( MPI_Comm t_comm, double t_length, unsigned t_discretization,
+                                    std::array<double,2> t_wind, Model::LexicoIndices t_start_fire_position,
+                                    double t_max_wind, std::uint64_t t_seed, std::array<int,2> t_dims,
+                                    unsigned t_granularity )
+    :   m_dims(process_grid(comm_size(t_comm), t_discretization, t_discretization, t_dims)),
+        m_comm(cartesian(t_comm, m_dims)),
+        m_coords(cart_coords(m_comm)),
+        m_granularity(block_granularity(t_discretization, m_dims, t_granularity)),
+        m_row_bounds(split_bounds(t_discretization, m_dims[0], m_granularity)),
+        m_column_bounds(split_bounds(t_discretization, m_dims[1], m_granularity)),
+        m_north(neighbour(m_comm, 0, -1)),
+        m_south(neighbour(m_comm, 0, +1)),
+        m_west (neighbour(m_comm, 1, -1)),
+        m_east (neighbour(m_comm, 1, +1)),
+        m_model(t_length, t_discretization, t_wind, t_start_fire_position,
+                bounded_block(m_coords, m_row_bounds, m_column_bounds), t_max_wind, t_seed),
+        m_west_border(m_model.domain().nb_rows),
+        m_east_border(m_model.domain().nb_rows)
+{}
+// --------------------------------------------------------------------------------------------------------------------
+DistributedModel::~DistributedModel()
+{
+    MPI_Comm_free(&m_comm);
+}
+// --------------------------------------------------------------------------------------------------------------------
+std::array<int,2>
+DistributedModel::process_grid( int t_nb_processes, unsigned t_rows, unsigned t_columns, std::array<int,2> t_dims )
+{
+    // Parmi les factorisations de t_nb_processes compatibles avec t_dims (et laissant au moins une
+    // ligne et une colonne par bloc), on retient celle dont le bloc a le plus petit demi-périmètre :
+    // c'est le volume échangé à chaque pas. À égalité, on découpe de préférence en lignes.
+    std::array<int,2> best = {t_nb_processes, 1};
+    double best_perimeter = -1.;
+    for (int rows = 1; rows <= t_nb_processes; ++rows)
+    {
+        if (t_nb_processes % rows != 0) continue;
+        int columns = t_nb_processes/rows;
+        if ((t_dims[0] > 0 && rows != t_dims[0]) || (t_dims[1] > 0 && columns != t_dims[1])) continue;
+        if (unsigned(rows) > t_rows || unsigned(columns) > t_columns) continue;
+        double perimeter = double(t_rows)/rows + double(t_columns)/columns;
+        if (best_perimeter < 0. || perimeter < best_perimeter ||
+            (perimeter == best_perimeter && rows > best[0]))
+        {
+            best = {rows, columns};
+            best_perimeter = perimeter;
+        }
+    }
+    return best;
+}
+// --------------------------------------------------------------------------------------------------------------------
+Model::Domain
+DistributedModel::block( unsigned t_discretization, std::array<int,2> t_coords, std::array<int,2> t_dims )
+{
+    auto rows    = split(t_discretization, t_coords[0], t_dims[0]);
+    auto columns = split(t_discretization, t_coords[1], t_dims[1]);
+    return {rows[0], rows[1], columns[0], columns[1]};
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+DistributedModel::exchange_halos()
+{
+    start_exchange();
+    finish_exchange();
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+DistributedModel::start_exchange()
+{
+    // Chaque bord part vers le voisin correspondant, qui le range dans la ligne ou la colonne fantôme
+    // opposée. Au bord de la grille, MPI_PROC_NULL laisse la ligne ou la colonne fantôme nulle.
+    // Les coins ne sont pas échangés : la propagation ne suit que les quatre directions principales.
+    // Les lignes sont envoyées et reçues en place, les colonnes sont d'abord recopiées.
+    double start = MPI_Wtime();
+    const Model::Domain domain = m_model.domain();
+    const int width = int(domain.nb_columns), height = int(domain.nb_rows);
+    MPI_Irecv(m_model.halo_row(Model::Side::south),    width,  MPI_UINT8_T, m_south, tag_to_north, m_comm, &m_requests[0]);
+    MPI_Irecv(m_model.halo_row(Model::Side::north),    width,  MPI_UINT8_T, m_north, tag_to_south, m_comm, &m_requests[1]);
+    MPI_Irecv(m_model.halo_column(Model::Side::east),  height, MPI_UINT8_T, m_east,  tag_to_west,  m_comm, &m_requests[2]);
+    MPI_Irecv(m_model.halo_column(Model::Side::west),  height, MPI_UINT8_T, m_west,  tag_to_east,  m_comm, &m_requests[3]);
+
+    if (m_west != MPI_PROC_NULL) m_model.copy_border_column(Model::Side::west, m_west_border.data());
+    if (m_east != MPI_PROC_NULL) m_model.copy_border_column(Model::Side::east, m_east_border.data());
+    MPI_Isend(m_model.border_row(Model::Side::north), width,  MPI_UINT8_T, m_north, tag_to_north, m_comm, &m_requests[4]);
+    MPI_Isend(m_model.border_row(Model::Side::south), width,  MPI_UINT8_T, m_south, tag_to_south, m_comm, &m_requests[5]);
+    MPI_Isend(m_west_border.data(),                   height, MPI_UINT8_T, m_west,  tag_to_west,  m_comm, &m_requests[6]);
+    MPI_Isend(m_east_border.data(),                   height, MPI_UINT8_T, m_east,  tag_to_east,  m_comm, &m_requests[7]);
+
+    m_halo_bytes += std::uint64_t(m_north != MPI_PROC_NULL) * width  + std::uint64_t(m_south != MPI_PROC_NULL) * width
+                  + std::uint64_t(m_west  != MPI_PROC_NULL) * height + std::uint64_t(m_east  != MPI_PROC_NULL) * height;
+    m_halo_seconds += MPI_Wtime() - start;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+DistributedModel::finish_exchange()
+{
+    // Les envois sont aussi attendus : les bords et les colonnes copiées changent au pas suivant
+    double start = MPI_Wtime();
+    MPI_Waitall(int(m_requests.size()), m_requests.data(), MPI_STATUSES_IGNORE);
+    m_halo_seconds += MPI_Wtime() - start;
+}
+// --------------------------------------------------------------------------------------------------------------------
+bool
+DistributedModel::update()
+{
+    // En recouvrement, l'intérieur du bloc évolue pendant que les fantômes arrivent : il ne lit ni
+    // les fantômes ni ne modifie les bords envoyés, seul update_border() attend la fin de l'échange.
+    if (m_overlap) start_exchange();
+    else           exchange_halos();
+    double start = MPI_Wtime();
+    m_model.update_interior();
+    double interior_end = MPI_Wtime();
+    m_interior_seconds += interior_end - start;
+    if (m_overlap) finish_exchange();
+    double border_start = MPI_Wtime();
+    int running = m_model.update_border() ? 1 : 0;
+    m_border_seconds += MPI_Wtime() - border_start;
+    MPI_Allreduce(MPI_IN_PLACE, &running, 1, MPI_INT, MPI_LOR, m_comm);
+    if (running && m_rebalance_interval > 0 && m_model.time_step() % m_rebalance_interval == 0)
+        rebalance();
+    return running != 0;
+}
+// --------------------------------------------------------------------------------------------------------------------
+double
+DistributedModel::imbalance() const
+{
+    double local = double(m_model.fire_front().size()), maximum, total;
+    MPI_Allreduce(&local, &maximum, 1, MPI_DOUBLE, MPI_MAX, m_comm);
+    MPI_Allreduce(&local, &total,   1, MPI_DOUBLE, MPI_SUM, m_comm);
+    return total > 0. ? maximum*comm_size(m_comm)/total : 1.;
+}
+// --------------------------------------------------------------------------------------------------------------------
+bool
+DistributedModel::rebalance()
+{
+    // Le coût d'un pas est celui du front : on répartit les cases du front par ligne et par colonne
+    // de la grille. Les frontières étant communes à toute une ligne ou colonne de processus, le
+    // découpage reste rectilinéaire et chaque bloc garde au plus quatre voisins.
+    const Model::Domain domain = m_model.domain();
+    const unsigned discretization = m_model.geometry();
+    std::vector<unsigned> row_cells(discretization, 0u), column_cells(discretization, 0u);
+    for (auto cell : m_model.fire_front())
+    {
+        row_cells   [domain.first_row    + cell.index/domain.nb_columns] += 1;
+        column_cells[domain.first_column + cell.index%domain.nb_columns] += 1;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, row_cells.data(),    int(discretization), MPI_UNSIGNED, MPI_SUM, m_comm);
+    MPI_Allreduce(MPI_IN_PLACE, column_cells.data(), int(discretization), MPI_UNSIGNED, MPI_SUM, m_comm);
+
+    // En deçà de 10 % de déséquilibre, la migration coûte plus qu'elle ne rapporte
+    constexpr double tolerance = 1.1;
+    m_imbalance_before = imbalance();
+    std::vector<unsigned> row_bounds    = balanced_bounds(row_cells, m_row_bounds, m_granularity);
+    std::vector<unsigned> column_bounds = balanced_bounds(column_cells, m_column_bounds, m_granularity);
+    if (m_imbalance_before <= tolerance || (row_bounds == m_row_bounds && column_bounds == m_column_bounds))
+    {
+        m_imbalance_after = m_imbalance_before;
+        return false;
+    }
+    migrate(row_bounds, column_bounds);
+    m_imbalance_after = imbalance();
+    m_nb_rebalances += 1;
+    return true;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+DistributedModel::migrate( std::vector<unsigned> const& t_row_bounds, std::vector<unsigned> const& t_column_bounds )
+{
+    // Chaque processus envoie à chacun l'intersection de son ancien bloc avec le nouveau bloc du
+    // destinataire : végétation, feu puis intensité du front, ligne par ligne. Le destinataire
+    // reconstitue son nouveau bloc à partir des intersections reçues de tous les anciens blocs.
+    const int nb_processes = comm_size(m_comm);
+    const Model::Domain old_block = m_model.domain();
+    const Model::Domain new_block = bounded_block(m_coords, t_row_bounds, t_column_bounds);
+    const std::array<std::uint8_t const*,3> old_planes = {m_model.vegetal_map().data(), m_model.fire_map().data(),
+                                                          m_model.fire_front().data()};
+
+    std::vector<int> send_counts(nb_processes), send_offsets(nb_processes);
+    std::vector<int> receive_counts(nb_processes), receive_offsets(nb_processes);
+    std::vector<std::uint8_t> send_buffer;
+    int received = 0;
+    for (int rank = 0; rank < nb_processes; ++rank)
+    {
+        std::array<int,2> coords = cart_coords(m_comm, rank);
+        Model::Domain part = intersection(old_block, bounded_block(coords, t_row_bounds, t_column_bounds));
+        send_offsets[rank] = int(send_buffer.size());
+        for (auto plane : old_planes)
+            for (unsigned row = part.first_row; row < part.first_row + part.nb_rows; ++row)
+            {
+                std::uint8_t const* first = plane + std::size_t(row - old_block.first_row)*old_block.nb_columns
+                                          + (part.first_column - old_block.first_column);
+                send_buffer.insert(send_buffer.end(), first, first + part.nb_columns);
+            }
+        send_counts[rank] = int(send_buffer.size()) - send_offsets[rank];
+
+        Model::Domain incoming = intersection(new_block, bounded_block(coords, m_row_bounds, m_column_bounds));
+        receive_offsets[rank] = received;
+        receive_counts[rank]  = int(3*incoming.nb_rows*incoming.nb_columns);
+        received += receive_counts[rank];
+    }
+    std::vector<std::uint8_t> receive_buffer(received);
+    MPI_Alltoallv(send_buffer.data(), send_counts.data(), send_offsets.data(), MPI_UINT8_T,
+                  receive_buffer.data(), receive_counts.data(), receive_offsets.data(), MPI_UINT8_T, m_comm);
+
+    const std::size_t nb_cells = std::size_t(new_block.nb_rows)*new_block.nb_columns;
+    std::vector<std::uint8_t> new_planes(3*nb_cells);
+    for (int rank = 0; rank < nb_processes; ++rank)
+    {
+        Model::Domain part = intersection(new_block, bounded_block(cart_coords(m_comm, rank), m_row_bounds, m_column_bounds));
+        std::uint8_t const* source = receive_buffer.data() + receive_offsets[rank];
+        for (std::size_t plane = 0; plane < 3; ++plane)
+            for (unsigned row = part.first_row; row < part.first_row + part.nb_rows; ++row)
+            {
+                std::uint8_t* first = new_planes.data() + plane*nb_cells
+                                    + std::size_t(row - new_block.first_row)*new_block.nb_columns
+                                    + (part.first_column - new_block.first_column);
+                std::copy(source, source + part.nb_columns, first);
+                source += part.nb_columns;
+            }
+    }
+    m_model.set_domain(new_block, new_planes.data(), new_planes.data() + nb_cells, new_planes.data() + 2*nb_cells);
+    m_row_bounds    = t_row_bounds;
+    m_column_bounds = t_column_bounds;
+    m_west_border.resize(new_block.nb_rows);
+    m_east_border.resize(new_block.nb_rows);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+DistributedModel::save_checkpoint( std::string const& t_path ) const
+{
+    // Écriture sous un nom temporaire, renommé une fois le fichier complet : une panne pendant
+    // l'écriture laisse intact le point de sauvegarde précédent
+    const std::string temporary = t_path + ".tmp";
+    const Model::Domain block = m_model.domain();
+    const CheckpointHeader header = checkpoint_header(m_model);
+    const std::array<std::uint8_t const*,3> planes = {m_model.vegetal_map().data(), m_model.fire_map().data(),
+                                                      m_model.fire_front().data()};
+    int rank;
+    MPI_Comm_rank(m_comm, &rank);
+
+    MPI_File file;
+    bool success = MPI_File_open(m_comm, temporary.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+                                 &file) == MPI_SUCCESS;
+    check_all(m_comm, success, "Impossible de créer le point de sauvegarde " + temporary);
+    // Taille fixée d'emblée : un fichier plus long, laissé par une écriture précédente, est tronqué
+    success = MPI_File_set_size(file, MPI_Offset(header.plane_offset(3))) == MPI_SUCCESS;
+    if (rank == 0)
+        success = success && MPI_File_write_at(file, 0, &header, int(sizeof(header)), MPI_BYTE,
+                                               MPI_STATUS_IGNORE) == MPI_SUCCESS;
+    // Une écriture collective par plan : la vue de chaque processus ne montre que son bloc, le front
+    // local est contigu (pas d'une ligne = largeur du bloc)
+    MPI_Datatype file_block = plane_block(block, header.geometry);
+    const int nb_cells = int(block.nb_rows*block.nb_columns);
+    for (unsigned plane = 0; plane < 3; ++plane)
+    {
+        MPI_File_set_view(file, MPI_Offset(header.plane_offset(plane)), MPI_UINT8_T, file_block, "native", MPI_INFO_NULL);
+        success = MPI_File_write_all(file, planes[plane], nb_cells, MPI_UINT8_T, MPI_STATUS_IGNORE) == MPI_SUCCESS
+               && success;
+    }
+    MPI_Type_free(&file_block);
+    success = MPI_File_close(&file) == MPI_SUCCESS && success;
+    check_all(m_comm, success, "Écriture impossible du point de sauvegarde " + temporary);
+    if (rank == 0)
+        success = std::rename(temporary.c_str(), t_path.c_str()) == 0;
+    check_all(m_comm, success, "Impossible de renommer " + temporary + " en " + t_path);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+DistributedModel::load_checkpoint( std::string const& t_path )
+{
+    MPI_File file;
+    bool success = MPI_File_open(m_comm, t_path.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) == MPI_SUCCESS;
+    check_all(m_comm, success, "Impossible d'ouvrir le point de sauvegarde " + t_path);
+
+    CheckpointHeader header;
+    success = MPI_File_read_at_all(file, 0, &header, int(sizeof(header)), MPI_BYTE, MPI_STATUS_IGNORE) == MPI_SUCCESS
+           && header.valid();
+    const bool valid = all_succeeded(m_comm, success);
+    // La reprise n'est identique que pour les mêmes paramètres : le modèle doit avoir été construit d'après l'en-tête
+    const CheckpointHeader expected = checkpoint_header(m_model);
+    const bool same_model = valid && header.geometry == expected.geometry && header.seed == expected.seed
+                         && header.length == expected.length && header.wind[0] == expected.wind[0]
+                         && header.wind[1] == expected.wind[1] && header.max_wind == expected.max_wind;
+    if (!same_model)
+    {
+        MPI_File_close(&file);
+        throw std::runtime_error(valid ? "Paramètres du modèle différents de ceux du point de sauvegarde " + t_path
+                                       : "Format de point de sauvegarde inconnu : " + t_path);
+    }
+
+    // Chaque processus lit son bloc actuel dans chacun des trois plans globaux
+    const Model::Domain block = m_model.domain();
+    const std::size_t nb_cells = std::size_t(block.nb_rows)*block.nb_columns;
+    std::vector<std::uint8_t> planes(3*nb_cells);
+    MPI_Datatype file_block = plane_block(block, header.geometry);
+    for (unsigned plane = 0; plane < 3; ++plane)
+    {
+        MPI_File_set_view(file, MPI_Offset(header.plane_offset(plane)), MPI_UINT8_T, file_block, "native", MPI_INFO_NULL);
+        MPI_Status status;
+        int count = 0;
+        success = MPI_File_read_all(file, planes.data() + plane*nb_cells, int(nb_cells), MPI_UINT8_T, &status) == MPI_SUCCESS
+               && MPI_Get_count(&status, MPI_UINT8_T, &count) == MPI_SUCCESS && std::size_t(count) == nb_cells && success;
+    }
+    MPI_Type_free(&file_block);
+    MPI_File_close(&file);
+    check_all(m_comm, success, "Point de sauvegarde incomplet : " + t_path);
+
+    m_model.set_domain(block, planes.data(), planes.data() + nb_cells, planes.data() + 2*nb_cells);
+    m_model.set_time_step(header.time_step);
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <mpi.h>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <string>
+#include "model.hpp"
+
+/**
+ * @brief Modèle réparti par blocs entre les processus d'une grille cartésienne MPI.
+ *
+ * Chaque processus n'alloue et ne fait évoluer que son bloc (Model restreint à un sous-domaine).
+ * À chaque pas, les intensités du front sur les quatre bords du bloc sont envoyées aux voisins
+ * Nord, Sud, Ouest et Est, qui les rangent dans leurs lignes et colonnes fantômes : ce sont les
+ * quatre directions de propagation du modèle. Par défaut l'échange est non bloquant et recouvert
+ * par l'évolution des cases intérieures du bloc ; seules les cases du bord attendent les fantômes.
+ *
+ * Les blocs forment un découpage rectilinéaire de la grille : des frontières de lignes communes à
+ * chaque ligne de processus et des frontières de colonnes communes à chaque colonne. L'équilibrage
+ * dynamique déplace ces frontières pour suivre le front de feu. Les tirages étant indexés par la case globale, le
+ * résultat est identique case par case à celui d'un modèle non réparti de même graine, quelle
+ * que soit la grille de processus.
+ */
+class DistributedModel
+{
+public:
+    // t_dims : grille de processus {lignes, colonnes} ; une dimension nulle est choisie automatiquement.
+    // t_granularity : les frontières entre blocs sont des multiples de t_granularity (puissance de deux),
+    // divisée par deux tant qu'il n'y a pas assez d'unités pour tous les processus (cf. granularity()).
+    DistributedModel( MPI_Comm t_comm, double t_length, unsigned t_discretization, std::array<double,2> t_wind,
+                      Model::LexicoIndices t_start_fire_position, double t_max_wind = 60., std::uint64_t t_seed = 0,
+                      std::array<int,2> t_dims = {0, 0}, unsigned t_granularity = 1 );
+    DistributedModel( DistributedModel const & ) = delete;
+    ~DistributedModel();
+
+    DistributedModel& operator = ( DistributedModel const & ) = delete;
+
+    // Grille de processus minimisant le périmètre d'un bloc de t_rows x t_columns cases,
+    // en respectant les dimensions déjà fixées (non nulles) de t_dims
+    static std::array<int,2> process_grid( int t_nb_processes, unsigned t_rows, unsigned t_columns,
+                                           std::array<int,2> t_dims = {0, 0} );
+    // Bloc du processus de coordonnées t_coords : les lignes et colonnes en surnombre vont aux premiers
+    static Model::Domain block( unsigned t_discretization, std::array<int,2> t_coords, std::array<int,2> t_dims );
+
+    // Opération collective : échange des bords et pas de temps local.
+    // Renvoie vrai tant qu'un des processus a encore des cases en feu.
+    bool update();
+    // Échange recouvert par le calcul (vrai, par défaut) ou bloquant avant le pas (faux), pour comparaison
+    void set_overlap( bool t_overlap ) { m_overlap = t_overlap; }
+    bool overlap() const { return m_overlap; }
+
+    // Équilibrage dynamique par update() tous les t_interval pas de temps (0 : jamais)
+    void     set_rebalance_interval( unsigned t_interval ) { m_rebalance_interval = t_interval; }
+    unsigned rebalance_interval() const { return m_rebalance_interval; }
+    // Opération collective : les frontières entre blocs sont déplacées pour que chaque ligne et chaque
+    // colonne de processus porte autant de cases du front, puis l'état des cases change de processus.
+    // Renvoie vrai si les blocs ont changé.
+    bool     rebalance();
+    // Opération collective : plus grand front local rapporté au front moyen (1 : équilibre parfait)
+    double   imbalance() const;
+    // Déséquilibre mesuré avant et après le dernier équilibrage, et nombre de changements de blocs
+    double   imbalance_before() const { return m_imbalance_before; }
+    double   imbalance_after() const { return m_imbalance_after; }
+    unsigned rebalances() const { return m_nb_rebalances; }
+
+    // Opération collective : point de sauvegarde au format de checkpoint.hpp, écrit par MPI-IO. Chaque
+    // processus écrit son bloc à sa place dans les plans globaux du fichier, le processus 0 l'en-tête.
+    // Les erreurs lèvent std::runtime_error sur tous les processus.
+    void save_checkpoint( std::string const& t_path ) const;
+    // Opération collective : reprise d'un point de sauvegarde, quel que soit le nombre de processus qui
+    // l'a écrit. Chaque processus lit son bloc actuel ; les paramètres du modèle doivent être ceux de
+    // l'en-tête (cf. read_checkpoint_header). Les fantômes sont échangés par le update() suivant.
+    void load_checkpoint( std::string const& t_path );
+
+    Model&            local()       { return m_model; }
+    Model const&      local() const { return m_model; }
+    Model::Domain     domain() const { return m_model.domain(); }
+    MPI_Comm          communicator() const { return m_comm; }
+    std::array<int,2> dims() const { return m_dims; }
+    unsigned          granularity() const { return m_granularity; }
+
+    // Volume des bords envoyés aux voisins (octets) et temps passé bloqué dans les échanges, cumulés
+    std::uint64_t halo_bytes() const { return m_halo_bytes; }
+    double        halo_seconds() const { return m_halo_seconds; }
+    // Temps cumulés de l'évolution des cases intérieures et de celles du bord
+    double        interior_seconds() const { return m_interior_seconds; }
+    double        border_seconds() const { return m_border_seconds; }
+
+private:
+    void exchange_halos();
+    void start_exchange();
+    void finish_exchange();
+    void migrate( std::vector<unsigned> const& t_row_bounds, std::vector<unsigned> const& t_column_bounds );
+
+    std::array<int,2> m_dims;              // Grille de processus {lignes, colonnes}
+    MPI_Comm m_comm;                       // Communicateur cartésien propre au modèle
+    std::array<int,2> m_coords;
+    unsigned m_granularity;                // Les frontières entre blocs sont multiples de m_granularity
+    std::vector<unsigned> m_row_bounds;    // Ligne de processus i : lignes [m_row_bounds[i], m_row_bounds[i+1])
+    std::vector<unsigned> m_column_bounds; // Colonne de processus j : colonnes [m_column_bounds[j], m_column_bounds[j+1])
+    int m_north, m_south, m_west, m_east;  // Voisins (MPI_PROC_NULL au bord de la grille)
+    Model m_model;
+    std::vector<std::uint8_t> m_west_border, m_east_border; // Colonnes de bord, copiées pour l'envoi
+    std::array<MPI_Request,8> m_requests;  // Échange en cours : quatre réceptions puis quatre envois
+    bool m_overlap = true;
+    std::uint64_t m_halo_bytes = 0;
+    double m_halo_seconds = 0.;
+    double m_interior_seconds = 0., m_border_seconds = 0.;
+    unsigned m_rebalance_interval = 0;
+    unsigned m_nb_rebalances = 0;
+    double m_imbalance_before = 1., m_imbalance_after = 1.;
+};
@@ -0,0 +1,266 @@
+#include <mpi.h>
+#include <string>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <memory>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "model.hpp"
+#include "model_pool.hpp"
+#include "ensemble_model.hpp"
+#include "counter_rng.hpp"
+#include "burn_statistics.hpp"
+
+// Ensemble Monte-Carlo : un même scénario simulé par de nombreux membres (graines différentes, vent
+// perturbé), sans affichage. Les membres sont répartis entre les processus MPI puis entre leurs threads,
+// chacun calculant ses membres avec un Model mono-thread, ou par lots de K membres avancés ensemble
+// (EnsembleModel, option --batch : mêmes résultats, tests d'allumage vectorisés). Les statistiques de
+// brûlage sont accumulées pendant les calculs, réunies par thread puis par processus (MPI_Reduce) en
+// cartes de probabilité.
+// Le paramétrage de chaque membre ne dépend que de la graine et de son numéro : le résultat est le même
+// quels que soient le nombre de processus et de threads.
+struct ParamsType {
+    double length{1.};
+    unsigned discretization{100u};
+    std::array<double,2> wind{0.,0.};
+    std::array<double,2> start{0.5,0.5};  // Position du foyer, en fraction du terrain
+    Model::Engine engine{Model::Engine::sparse};
+    std::uint64_t seed{0};                // Graine du membre m : seed + m
+    std::uint64_t members{100};
+    unsigned batch{1};                    // Membres par lot (EnsembleModel si plus d'un)
+    double wind_sigma{0.};                // Écart-type de la perturbation de chaque composante du vent (km/h)
+    std::size_t max_steps{0};             // Pas par membre, 0 : jusqu'à l'extinction du feu
+    std::string output{"ensemble"};       // Préfixe des cartes produites
+};
+
+bool analyze_arg(int nargs, char* args[], ParamsType& params, bool verbose) {
+    for (int i = 1; i < nargs; ++i) {
+        std::string arg = args[i];
+        // Vrai si l'option est suivie de ses nb_values valeurs
+        auto has_values = [&](int nb_values) {
+            if (i + nb_values < nargs) return true;
+            if (verbose) std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
+            return false;
+        };
+        if (arg == "-l" || arg == "--length") {
+            if (!has_values(1)) return false;
+            params.length = std::stod(args[++i]);
+        }
+        else if (arg == "-d" || arg == "--discretization") {
+            if (!has_values(1)) return false;
+            params.discretization = std::stoul(args[++i]);
+        }
+        else if (arg == "-w" || arg == "--wind") {
+            if (!has_values(2)) return false;
+            params.wind[0] = std::stod(args[++i]);
+            params.wind[1] = std::stod(args[++i]);
+        }
+        else if (arg == "-s" || arg == "--start") {
+            if (!has_values(2)) return false;
+            params.start[0] = std::stod(args[++i]);
+            params.start[1] = std::stod(args[++i]);
+        }
+        else if (arg == "-e" || arg == "--engine") {
+            if (!has_values(1)) return false;
+            std::string name = args[++i];
+            if (name != "sparse" && name != "dense") {
+                if (verbose) std::cerr << "[ERREUR] Moteur inconnu : " << name << " (sparse ou dense)" << std::endl;
+                return false;
+            }
+            params.engine = name == "dense" ? Model::Engine::dense : Model::Engine::sparse;
+        }
+        else if (arg == "--seed") {
+            if (!has_values(1)) return false;
+            params.seed = std::stoull(args[++i]);
+        }
+        else if (arg == "-m" || arg == "--members") {
+            if (!has_values(1)) return false;
+            params.members = std::stoull(args[++i]);
+        }
+        else if (arg == "-k" || arg == "--batch") {
+            if (!has_values(1)) return false;
+            params.batch = std::stoul(args[++i]);
+        }
+        else if (arg == "--wind-sigma") {
+            if (!has_values(1)) return false;
+            params.wind_sigma = std::stod(args[++i]);
+        }
+        else if (arg == "-n" || arg == "--steps") {
+            if (!has_values(1)) return false;
+            params.max_steps = std::stoull(args[++i]);
+        }
+        else if (arg == "-o" || arg == "--output") {
+            if (!has_values(1)) return false;
+            params.output = args[++i];
+        }
+        else {
+            if (verbose) {
+                if (arg != "-h" && arg != "--help")
+                    std::cerr << "[ERREUR] Option inconnue : " << arg << std::endl;
+                std::cout << "Usage : " << args[0] << " [-l longueur] [-d cases] [-w vx vy] [-s x y] [-e sparse|dense]\n"
+                          << "        [--seed graine] [-m membres] [-k membres par lot]\n"
+                          << "        [--wind-sigma écart-type] [-n pas] [-o préfixe]"
+                          << std::endl;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+bool check_params(ParamsType const& params, bool verbose) {
+    std::string error;
+    if (params.length <= 0)
+        error = "La longueur doit être positive.";
+    else if (params.discretization == 0)
+        error = "Le nombre de cellules doit être positif.";
+    else if (params.start[0] < 0 || params.start[0] > 1 || params.start[1] < 0 || params.start[1] > 1)
+        error = "La position du foyer doit être entre 0 et 1.";
+    else if (params.members == 0)
+        error = "Le nombre de membres doit être positif.";
+    else if (params.batch == 0)
+        error = "Un lot compte au moins un membre.";
+    else if (params.wind_sigma < 0)
+        error = "L'écart-type du vent doit être positif ou nul.";
+    if (!error.empty() && verbose)
+        std::cerr << "[ERREUR] " << error << std::endl;
+    return error.empty();
+}
+
+// Vent du membre t_member : vent moyen plus un bruit gaussien (Box-Muller) tiré de (graine, membre), sur
+// un flux distinct de ceux du modèle
+std::array<double,2> member_wind(ParamsType const& params, std::uint64_t t_member) {
+    constexpr std::uint32_t wind_stream = 2;
+    if (params.wind_sigma == 0) return params.wind;
+    CounterRng::Block draw = CounterRng(params.seed)(std::uint32_t(t_member), std::uint32_t(t_member >> 32), wind_stream);
+    const double u1 = (draw[0] + 1.) / 4294967296.;  // Dans ]0, 1]
+    const double u2 = draw[1] / 4294967296.;
+    const double radius = params.wind_sigma * std::sqrt(-2. * std::log(u1));
+    const double angle = 2. * M_PI * u2;
+    return {params.wind[0] + radius * std::cos(angle), params.wind[1] + radius * std::sin(angle)};
+}
+
+int main(int nargs, char* args[]) {
+    MPI_Init(&nargs, &args);
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    ParamsType params;
+    if (!analyze_arg(nargs, args, params, rank == 0) || !check_params(params, rank == 0)) {
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+    const unsigned d = params.discretization;
+    const Model::LexicoIndices start{std::min(unsigned(params.start[0] * d), d - 1),
+                                     std::min(unsigned(params.start[1] * d), d - 1)};
+    if (rank == 0) {
+        std::cout << "Ensemble : " << params.members << " membres - grille " << d << " x " << d
+                  << " - vent [" << params.wind[0] << ", " << params.wind[1] << "] +/- " << params.wind_sigma
+                  << " - " << size << " processus" << std::endl;
+    }
+
+    // Lots de membres consécutifs du processus : rank, rank + size, ... ; les threads se les partagent
+    // dynamiquement (durées très variables d'un lot à l'autre). Chaque thread accumule ses propres statistiques.
+    MPI_Barrier(MPI_COMM_WORLD);
+    auto start_time = std::chrono::steady_clock::now();
+    // Membres calculés un par un : un modèle par thread, remis à zéro d'un membre à l'autre
+#if defined(_OPENMP)
+    const std::size_t nb_threads = std::size_t(omp_get_max_threads());
+#else
+    const std::size_t nb_threads = 1;
+#endif
+    std::unique_ptr<ModelPool> pool;
+    if (params.batch == 1)
+        pool = std::make_unique<ModelPool>(params.length, d, nb_threads, 10.0);
+    BurnStatistics statistics(d);
+    std::uint64_t nb_steps = 0;
+#pragma omp parallel reduction(+:nb_steps)
+    {
+        BurnStatistics thread_statistics(d);
+        // Avance un modèle (Model ou EnsembleModel) jusqu'à l'extinction ou au nombre de pas demandé
+        auto run = [&](auto& simu) {
+            thread_statistics.observe(simu);
+            std::size_t iteration = 0;
+            bool running = true;
+            while (running && (params.max_steps == 0 || iteration < params.max_steps)) {
+                running = simu.update();
+                thread_statistics.observe(simu);
+                iteration++;
+            }
+            thread_statistics.finish_member();
+            return iteration;
+        };
+        const std::uint64_t nb_batches = (params.members + params.batch - 1) / params.batch;
+#pragma omp for schedule(dynamic) nowait
+        for (std::uint64_t batch = std::uint64_t(rank); batch < nb_batches; batch += std::uint64_t(size)) {
+            const std::uint64_t first = batch * params.batch;
+            const std::uint64_t last = std::min(first + params.batch, params.members);
+            if (params.batch == 1) {
+                ModelPool::Lease simu = pool->acquire(member_wind(params, first), start, params.seed + first);
+                simu->set_engine(params.engine);
+                simu->set_threads(1);
+                nb_steps += run(*simu);
+            }
+            else {
+                std::vector<std::array<double,2>> winds;
+                std::vector<std::uint64_t> seeds;
+                for (std::uint64_t member = first; member < last; ++member) {
+                    winds.push_back(member_wind(params, member));
+                    seeds.push_back(params.seed + member);
+                }
+                EnsembleModel simu(params.length, d, winds, start, seeds, 10.0);
+                nb_steps += (last - first) * run(simu);
+            }
+        }
+#pragma omp critical
+        statistics.merge(thread_statistics);
+    }
+    auto compute_end = std::chrono::steady_clock::now();
+
+    // Réduction des totaux (entiers : le résultat ne dépend pas de l'ordre des processus)
+    const int nb_cells = int(std::size_t(d) * d);
+    std::uint64_t totals[2] = {statistics.members(), nb_steps};
+    if (rank == 0) {
+        MPI_Reduce(MPI_IN_PLACE, statistics.counts().data(), nb_cells, MPI_UINT32_T, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(MPI_IN_PLACE, statistics.arrival_sums().data(), nb_cells, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(MPI_IN_PLACE, statistics.arrival_squares().data(), nb_cells, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(MPI_IN_PLACE, totals, 2, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+    }
+    else {
+        MPI_Reduce(statistics.counts().data(), nullptr, nb_cells, MPI_UINT32_T, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(statistics.arrival_sums().data(), nullptr, nb_cells, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(statistics.arrival_squares().data(), nullptr, nb_cells, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(totals, nullptr, 2, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+    }
+    auto end_time = std::chrono::steady_clock::now();
+
+    int status = EXIT_SUCCESS;
+    if (rank == 0) {
+        statistics.set_members(totals[0]);
+        double seconds = std::chrono::duration<double>(end_time - start_time).count();
+        double reduce_seconds = std::chrono::duration<double>(end_time - compute_end).count();
+        double burnt_area = 0.;
+        for (std::size_t cell = 0; cell < std::size_t(nb_cells); ++cell)
+            burnt_area += statistics.probability(cell);
+        std::cout << "Membres : " << totals[0] << " - pas simulés : " << totals[1] << " - temps : " << seconds << " s"
+                  << " (dont réduction : " << reduce_seconds << " s)" << std::endl;
+        std::cout << "Débit : " << totals[0] / seconds * 3600. << " membres par heure - "
+                  << totals[1] / seconds << " pas/s" << std::endl;
+        std::cout << "Surface brûlée moyenne : " << burnt_area << " cases ("
+                  << 100. * burnt_area / nb_cells << " % du terrain)" << std::endl;
+        if (statistics.write(params.output))
+            std::cout << "Cartes : " << params.output << "_probability.pgm, " << params.output << "_arrival.pgm, "
+                      << params.output << ".csv" << std::endl;
+        else
+            status = EXIT_FAILURE;
+    }
+    MPI_Finalize();
+    return status;
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "counter_rng.hpp"
+#include "ensemble_model.hpp"
+
+EnsembleModel::EnsembleModel( double t_length, unsigned t_discretization, std::vector<std::array<double,2>> const& t_winds,
+                              Model::LexicoIndices t_start_fire_position, std::vector<std::uint64_t> const& t_seeds,
+                              double t_max_wind )
+    :   m_members(unsigned(t_seeds.size())),
+        m_geometry(t_discretization),
+        m_vegetation(std::size_t(t_discretization)*t_discretization*t_seeds.size(), 255u),
+        m_fire(std::size_t(t_discretization)*t_discretization*t_seeds.size(), 0u),
+        m_intensity(std::size_t(t_discretization)*t_discretization*t_seeds.size(), 0u),
+        m_next_intensity(std::size_t(t_discretization)*t_discretization*t_seeds.size(), 0u),
+        m_listed(std::size_t(t_discretization)*t_discretization, 0u),
+        m_ignition_coef(std::size_t(4*256)*t_seeds.size()),
+        m_keys_low(t_seeds.size()),
+        m_keys_high(t_seeds.size())
+{
+    if (t_seeds.empty() || t_winds.size() != t_seeds.size())
+    {
+        throw std::range_error("Il faut au moins un membre, et un vent par membre.");
+    }
+    if (t_discretization == 0)
+    {
+        throw std::range_error("Le nombre de cases par direction doit être plus grand que zéro.");
+    }
+    // Seuils et clés de chaque membre repris d'un Model réduit à une case : exactement ceux du modèle
+    // complet, sans allouer sa grille
+    for (unsigned k = 0; k < m_members; ++k)
+    {
+        Model member(t_length, t_discretization, t_winds[k], t_start_fire_position, Model::Domain{0u, 1u, 0u, 1u},
+                     t_max_wind, t_seeds[k]);
+        for (unsigned d = 0; d < 4; ++d)
+            std::copy(member.ignition_coefficients()[d].begin(), member.ignition_coefficients()[d].end(),
+                      m_ignition_coef.begin() + (std::size_t(k)*4 + d)*256);
+        m_green_coef = member.green_coefficients();
+        m_extinction_threshold = member.extinction_threshold();
+        std::array<std::uint32_t,2> key = CounterRng(t_seeds[k]).key();
+        m_keys_low[k]  = key[0];
+        m_keys_high[k] = key[1];
+    }
+    for (auto& words : m_draws) words.resize(m_members);
+
+    const std::uint32_t start = t_start_fire_position.row*m_geometry + t_start_fire_position.column;
+    std::fill_n(m_fire.begin() + std::size_t(start)*m_members, m_members, 255u);
+    std::fill_n(m_intensity.begin() + std::size_t(start)*m_members, m_members, 255u);
+    m_active.push_back(start);
+}
+// --------------------------------------------------------------------------------------------------------------------
+bool
+EnsembleModel::update()
+{
+    // Mêmes phases que le moteur creux de Model : propagation depuis l'état en début de pas, puis
+    // combustion des cases du front. m_next_intensity est nul en dehors des cases listées.
+    m_next_active.clear();
+    for (auto cell : m_active) spread(cell);
+    for (auto cell : m_active) burn(cell);
+
+    std::sort(m_next_active.begin(), m_next_active.end());
+    for (auto cell : m_next_active) m_listed[cell] = 0u;
+    // L'ancien état ne reste non nul que sur les cases de l'ancien front : elles seules sont remises à zéro
+    for (auto cell : m_active)
+        std::memset(m_intensity.data() + std::size_t(cell)*m_members, 0, m_members);
+    m_intensity.swap(m_next_intensity);
+    m_active.swap(m_next_active);
+    m_time_step += 1;
+    return !m_active.empty();
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+EnsembleModel::list( std::uint32_t t_cell )
+{
+    if (m_listed[t_cell]) return;
+    m_listed[t_cell] = 1u;
+    m_next_active.push_back(t_cell);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+EnsembleModel::spread( std::uint32_t t_cell )
+{
+    const unsigned nb_members = m_members;
+    CounterRng::fill_seeds(m_keys_low.data(), m_keys_high.data(), nb_members, t_cell, std::uint32_t(m_time_step),
+                           ignition_stream, {m_draws[0].data(), m_draws[1].data(), m_draws[2].data(), m_draws[3].data()});
+    std::uint8_t const* source = m_intensity.data() + std::size_t(t_cell)*nb_members;
+    const unsigned row = t_cell/m_geometry, column = t_cell%m_geometry;
+
+    // Voisines dans la grille, calculées une fois pour tous les membres
+    std::array<std::uint32_t,4> targets;
+    std::array<Direction,4> directions;
+    unsigned nb_targets = 0;
+    if (row < m_geometry-1)    { targets[nb_targets] = t_cell + m_geometry; directions[nb_targets++] = South; }
+    if (row > 0)               { targets[nb_targets] = t_cell - m_geometry; directions[nb_targets++] = North; }
+    if (column < m_geometry-1) { targets[nb_targets] = t_cell + 1;          directions[nb_targets++] = East;  }
+    if (column > 0)            { targets[nb_targets] = t_cell - 1;          directions[nb_targets++] = West;  }
+
+    for (unsigned t = 0; t < nb_targets; ++t)
+    {
+        const std::size_t offset = std::size_t(targets[t])*nb_members;
+        std::uint8_t const* vegetation = m_vegetation.data() + offset;
+        std::uint8_t* next = m_next_intensity.data() + offset;
+        std::uint8_t* fire = m_fire.data() + offset;
+        std::uint32_t const* draws = m_draws[directions[t]].data();
+        std::uint32_t const* coef = m_ignition_coef.data() + std::size_t(directions[t])*256;
+        std::uint32_t const* green = m_green_coef.data();
+        // Membres hors du front : intensité nulle, seuil nul, pas d'allumage
+        unsigned ignited = 0;
+#pragma omp simd reduction(|:ignited)
+        for (unsigned k = 0; k < nb_members; ++k)
+        {
+            const bool ignites = (draws[k] >> 2) < std::uint64_t(coef[k*4*256 + source[k]])*green[vegetation[k]];
+            next[k] = ignites ? std::uint8_t(255u) : next[k];
+            fire[k] = ignites ? std::uint8_t(255u) : fire[k];
+            ignited |= ignites ? 1u : 0u;
+        }
+        if (ignited) list(targets[t]);
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+EnsembleModel::burn( std::uint32_t t_cell )
+{
+    const unsigned nb_members = m_members;
+    CounterRng::fill_seeds(m_keys_low.data(), m_keys_high.data(), nb_members, t_cell, std::uint32_t(m_time_step),
+                           extinction_stream, {m_draws[0].data(), m_draws[1].data(), m_draws[2].data(), m_draws[3].data()});
+    const std::size_t offset = std::size_t(t_cell)*nb_members;
+    std::uint8_t const* current = m_intensity.data() + offset;
+    std::uint8_t* next = m_next_intensity.data() + offset;
+    std::uint8_t* vegetation = m_vegetation.data() + offset;
+    std::uint8_t* fire = m_fire.data() + offset;
+    std::uint32_t const* draws = m_draws[0].data();
+    const std::uint32_t threshold = m_extinction_threshold;
+    unsigned burning = 0;
+#pragma omp simd reduction(|:burning)
+    for (unsigned k = 0; k < nb_members; ++k)
+    {
+        // Membre en feu : une case rallumée pendant la propagation repart de 255. Un membre hors du front
+        // garde son éventuel nouvel allumage (255).
+        const bool in_front = current[k] != 0;
+        unsigned intensity = next[k] != 0 ? 255u : current[k];
+        const bool has_vegetation = vegetation[k] > 0;
+        if (has_vegetation && (draws[k] >> 2) < threshold)
+            intensity = intensity/2 <= 1 ? 0u : intensity/2;
+        if (!has_vegetation) intensity = 0u;
+        const bool extinct = in_front && intensity == 0;
+        const std::uint8_t burnt = std::uint8_t(has_vegetation ? vegetation[k] - 1 : 0);
+        vegetation[k] = in_front ? (extinct ? std::uint8_t(0u) : burnt) : vegetation[k];
+        fire[k] = extinct ? std::uint8_t(0u) : fire[k];
+        next[k] = in_front ? std::uint8_t(intensity) : next[k];
+        burning |= next[k];
+    }
+    if (burning) list(t_cell);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+EnsembleModel::copy_member( unsigned t_member, std::uint8_t* t_vegetation, std::uint8_t* t_fire,
+                            std::uint8_t* t_intensity ) const
+{
+    const std::size_t nb_cells = std::size_t(m_geometry)*m_geometry;
+    for (std::size_t cell = 0; cell < nb_cells; ++cell)
+    {
+        t_vegetation[cell] = m_vegetation[cell*m_members + t_member];
+        t_fire[cell]       = m_fire[cell*m_members + t_member];
+        if (t_intensity) t_intensity[cell] = m_intensity[cell*m_members + t_member];
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "model.hpp"
+
+/**
+ * @brief K membres d'un ensemble (même terrain et même foyer, graine et vent propres à chaque membre)
+ * avancés ensemble, pas par pas.
+ *
+ * L'état est rangé case par case : les K octets de végétation (de feu, d'intensité) d'une case sont
+ * contigus, membre k en position k. Les cases parcourues sont celles où au moins un membre est en feu ;
+ * pour chacune, le calcul des voisines et les tests de bord sont faits une fois, puis les K membres sont
+ * traités par une boucle vectorisable : tirages Philox des K graines, seuils d'allumage et combustion.
+ *
+ * Chaque membre suit exactement la même évolution qu'un Model de même graine et de même vent : mêmes
+ * tirages, mêmes seuils (repris d'un Model), mêmes règles. Un EnsembleModel n'utilise qu'un thread ;
+ * un ensemble se répartit entre threads par lots de membres.
+ */
+class EnsembleModel
+{
+public:
+    EnsembleModel( double t_length, unsigned t_discretization, std::vector<std::array<double,2>> const& t_winds,
+                   Model::LexicoIndices t_start_fire_position, std::vector<std::uint64_t> const& t_seeds,
+                   double t_max_wind = 60. );
+    EnsembleModel( EnsembleModel const & ) = delete;
+    EnsembleModel( EnsembleModel      && ) = default;
+    ~EnsembleModel() = default;
+
+    EnsembleModel& operator = ( EnsembleModel const & ) = delete;
+    EnsembleModel& operator = ( EnsembleModel      && ) = default;
+
+    // Un pas de temps pour tous les membres ; renvoie vrai tant qu'un des membres a des cases en feu
+    bool update();
+
+    unsigned    members() const { return m_members; }
+    unsigned    geometry() const { return m_geometry; }
+    std::size_t time_step() const { return m_time_step; }
+    // Cases où au moins un membre est en feu, dans l'ordre croissant
+    std::vector<std::uint32_t> const& active_cells() const { return m_active; }
+    // État de la case t_cell pour le membre t_member
+    std::uint8_t vegetation( std::size_t t_cell, unsigned t_member ) const { return m_vegetation[t_cell*m_members + t_member]; }
+    std::uint8_t fire      ( std::size_t t_cell, unsigned t_member ) const { return m_fire[t_cell*m_members + t_member]; }
+    std::uint8_t intensity ( std::size_t t_cell, unsigned t_member ) const { return m_intensity[t_cell*m_members + t_member]; }
+    // Cartes du membre t_member, recopiées dans des tableaux de geometry()² octets (t_intensity peut être nul)
+    void copy_member( unsigned t_member, std::uint8_t* t_vegetation, std::uint8_t* t_fire,
+                      std::uint8_t* t_intensity = nullptr ) const;
+
+private:
+    // Flux de tirages de Model
+    static constexpr std::uint32_t ignition_stream = 0, extinction_stream = 1;
+    enum Direction : std::uint32_t { South = 0, North = 1, East = 2, West = 3 };
+
+    void spread( std::uint32_t t_cell );
+    void burn  ( std::uint32_t t_cell );
+    void list  ( std::uint32_t t_cell );
+
+    unsigned m_members;
+    unsigned m_geometry;
+    std::size_t m_time_step = 0;
+    // Cases x membres : octet t_cell*m_members + membre
+    std::vector<std::uint8_t> m_vegetation, m_fire, m_intensity, m_next_intensity;
+    std::vector<std::uint32_t> m_active, m_next_active;
+    std::vector<std::uint8_t>  m_listed;          // 1 si la case est déjà dans m_next_active
+    // Seuils d'allumage par membre, direction et intensité de la source : m_ignition_coef[(k*4 + d)*256 + i]
+    std::vector<std::uint32_t> m_ignition_coef;
+    std::array<std::uint32_t,256> m_green_coef;
+    std::uint32_t m_extinction_threshold;
+    std::vector<std::uint32_t> m_keys_low, m_keys_high; // Clés Philox des membres
+    std::array<std::vector<std::uint32_t>,4> m_draws;  // Tirages de la case courante, un mot par direction
+};
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include "fire_front.hpp"
+
+FireFront::FireFront( std::size_t t_nb_cells, std::size_t t_row_length )
+    :   m_intensity(t_nb_cells + 2*(t_row_length+1), 0u),
+        m_listed(t_nb_cells, 0u),
+        m_padding(t_row_length+1)
+{}
+// --------------------------------------------------------------------------------------------------------------------
+void
+FireFront::insert( std::size_t t_index, std::uint8_t t_intensity )
+{
+    m_intensity[m_padding + t_index] = t_intensity;
+    if (t_intensity != 0 && !m_listed[t_index])
+    {
+        m_listed[t_index] = 1u;
+        m_cells.push_back(std::uint32_t(t_index));
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+FireFront::clear()
+{
+    // On ne remet à zéro que les cases listées : coût proportionnel à la taille du front
+    for (auto index : m_cells)
+    {
+        m_intensity[m_padding + index] = 0u;
+        m_listed[index] = 0u;
+    }
+    m_cells.clear();
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+FireFront::reset()
+{
+    // Hors de la bordure, seules les cases listées sont non nulles : clear() suffit. La bordure
+    // (lignes fantômes écrites par un sous-domaine) est remise à zéro en entier.
+    clear();
+    std::fill_n(m_intensity.begin(), m_padding, std::uint8_t(0u));
+    std::fill_n(m_intensity.end() - std::ptrdiff_t(m_padding), m_padding, std::uint8_t(0u));
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+FireFront::compact()
+{
+    // Retrait des cases éteintes en conservant l'ordre relatif des indices restants
+    std::size_t nb_kept = 0;
+    for (auto index : m_cells)
+    {
+        if (m_intensity[m_padding + index] != 0)
+            m_cells[nb_kept++] = index;
+        else
+            m_listed[index] = 0u;
+    }
+    m_cells.resize(nb_kept);
+
+    // Seule la fin non triée du tableau est triée, puis fusionnée avec le préfixe déjà trié
+    auto middle = std::is_sorted_until(m_cells.begin(), m_cells.end());
+    if (middle != m_cells.end())
+    {
+        std::sort(middle, m_cells.end());
+        if (middle != m_cells.begin() && *(middle-1) > *middle)
+        {
+            m_merge_buffer.resize(m_cells.size());
+            std::merge(m_cells.begin(), middle, middle, m_cells.end(), m_merge_buffer.begin());
+            m_cells.swap(m_merge_buffer);
+        }
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+FireFront::swap( FireFront& t_other )
+{
+    m_cells.swap(t_other.m_cells);
+    m_merge_buffer.swap(t_other.m_merge_buffer);
+    m_intensity.swap(t_other.m_intensity);
+    m_listed.swap(t_other.m_listed);
+    std::swap(m_padding, t_other.m_padding);
+}
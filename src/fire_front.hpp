@@ -0,0 +1,122 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+/**
+ * @brief Front de feu : tableau compact des cases actives + intensité dense par case.
+ *
+ * Les indices des cases en feu sont rangés dans un tableau contigu, trié (ordre mémoire)
+ * après chaque appel à compact(). L'intensité du foyer est stockée dans un tableau dense
+ * indexé par la case (0 = case hors du front). Insertion et suppression sont en O(1) et
+ * sans allocation par case : une suppression remet seulement l'intensité à zéro, l'indice
+ * est retiré du tableau au prochain compact(). Les indices ajoutés dans l'ordre croissant
+ * ne coûtent aucun tri : compact() ne trie que la partie du tableau qui ne l'est pas déjà.
+ *
+ * Le tableau d'intensité est bordé d'une ligne (plus une case) de chaque côté, nulle par défaut :
+ * un moteur de stencil peut lire les voisins Nord/Sud/Est/Ouest de toute case sans test de bornes.
+ * Un sous-domaine y range les intensités des lignes voisines (lignes fantômes).
+ */
+class FireFront
+{
+public:
+
+    struct Cell
+    {
+        std::size_t  index;
+        std::uint8_t intensity;
+    };
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = Cell;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = Cell;
+
+        const_iterator( FireFront const* t_front, std::size_t t_position )
+            :   m_front(t_front), m_position(t_position)
+        {}
+
+        Cell operator * () const { return (*m_front)[m_position]; }
+        Cell operator [] ( difference_type t_offset ) const { return (*m_front)[m_position + t_offset]; }
+
+        const_iterator& operator ++ () { ++m_position; return *this; }
+        const_iterator& operator -- () { --m_position; return *this; }
+        const_iterator  operator ++ ( int ) { auto it = *this; ++m_position; return it; }
+        const_iterator  operator -- ( int ) { auto it = *this; --m_position; return it; }
+        const_iterator& operator += ( difference_type t_offset ) { m_position += t_offset; return *this; }
+        const_iterator& operator -= ( difference_type t_offset ) { m_position -= t_offset; return *this; }
+        const_iterator  operator +  ( difference_type t_offset ) const { return {m_front, m_position + t_offset}; }
+        const_iterator  operator -  ( difference_type t_offset ) const { return {m_front, m_position - t_offset}; }
+        difference_type operator -  ( const_iterator const& t_other ) const
+        { return difference_type(m_position) - difference_type(t_other.m_position); }
+
+        bool operator == ( const_iterator const& t_other ) const { return m_position == t_other.m_position; }
+        bool operator != ( const_iterator const& t_other ) const { return m_position != t_other.m_position; }
+        bool operator <  ( const_iterator const& t_other ) const { return m_position <  t_other.m_position; }
+
+    private:
+        FireFront const* m_front;
+        std::size_t      m_position;
+    };
+
+    FireFront() = default;
+    FireFront( std::size_t t_nb_cells, std::size_t t_row_length );
+
+    void insert( std::size_t t_index, std::uint8_t t_intensity );
+    // Fixe l'intensité sans lister la case : un insert() ultérieur est attendu pour l'ajouter au parcours
+    void mark  ( std::size_t t_index, std::uint8_t t_intensity ) { m_intensity[m_padding + t_index] = t_intensity; }
+    void erase ( std::size_t t_index ) { m_intensity[m_padding + t_index] = 0; }
+    void clear ();
+    // Front vide, bordure (lignes fantômes) comprise, sans réallocation ni parcours du tableau entier
+    void reset ();
+    void compact();
+    void swap  ( FireFront& t_other );
+    // Remplissage parallèle : extend() ajoute t_count places au tableau des cases actives, que des
+    // threads distincts remplissent ensuite par place() avec des cases déjà marquées. Le tableau
+    // obtenu doit être trié et sans case éteinte : il est alors utilisable sans compact().
+    // La capacité croît géométriquement : un front qui grandit ne réalloue qu'un nombre logarithmique de fois.
+    void extend( std::size_t t_count )
+    {
+        const std::size_t size = m_cells.size() + t_count;
+        if (size > m_cells.capacity()) m_cells.reserve(std::max(2*m_cells.capacity(), size));
+        m_cells.resize(size);
+    }
+    void place ( std::size_t t_position, std::uint32_t t_index )
+    {
+        m_cells[t_position] = t_index;
+        m_listed[t_index]   = 1u;
+    }
+
+    bool         contains ( std::size_t t_index ) const { return m_intensity[m_padding + t_index] != 0; }
+    std::uint8_t intensity( std::size_t t_index ) const { return m_intensity[m_padding + t_index]; }
+    // Indices des cases actives (valides après compact())
+    std::uint32_t const* indices() const { return m_cells.data(); }
+    // Intensité de la case 0 ; la ligne précédente et la ligne suivante de la grille sont lisibles (nulles)
+    std::uint8_t const* data() const { return m_intensity.data() + m_padding; }
+    // Accès en écriture, réservé aux lignes fantômes d'un sous-domaine (bordure du tableau)
+    std::uint8_t*       data()       { return m_intensity.data() + m_padding; }
+
+    // Taille et parcours valides après compact() : cases actives, triées par indice croissant
+    std::size_t size () const { return m_cells.size(); }
+    bool        empty() const { return m_cells.empty(); }
+    Cell operator [] ( std::size_t t_position ) const
+    {
+        std::size_t index = m_cells[t_position];
+        return {index, m_intensity[m_padding + index]};
+    }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end  () const { return {this, m_cells.size()}; }
+
+private:
+    std::vector<std::uint32_t> m_cells;        // Indices listés
+    std::vector<std::uint32_t> m_merge_buffer; // Tampon réutilisé par compact()
+    std::vector<std::uint8_t>  m_intensity;    // Intensité du foyer par case (bordée), 0 hors du front
+    std::vector<std::uint8_t>  m_listed;       // 1 si l'indice est présent dans m_cells
+    std::size_t m_padding = 0;                 // Décalage de la case 0 dans m_intensity
+};
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cstring>
+#include "frame.hpp"
+
+namespace
+{
+    constexpr std::size_t header_words = 3;
+
+    void put_word( std::uint8_t* t_destination, std::uint32_t t_word )
+    {
+        std::memcpy(t_destination, &t_word, sizeof(t_word));
+    }
+
+    std::uint32_t get_word( std::uint8_t const* t_source )
+    {
+        std::uint32_t word;
+        std::memcpy(&word, t_source, sizeof(word));
+        return word;
+    }
+
+    // Vrai si les t_count octets de t_first et t_second diffèrent. Un bloc complet est comparé en deux
+    // mots de 64 bits, sans appel à memcmp : la comparaison de toute la carte domine le codage.
+    bool differs( std::uint8_t const* t_first, std::uint8_t const* t_second, std::size_t t_count )
+    {
+        static_assert(FrameEncoder::block_size == 16, "un bloc complet tient en deux mots de 64 bits");
+        if (t_count != FrameEncoder::block_size) return std::memcmp(t_first, t_second, t_count) != 0;
+        std::uint64_t first[2], second[2];
+        std::memcpy(first, t_first, sizeof(first));
+        std::memcpy(second, t_second, sizeof(second));
+        return ((first[0] ^ second[0]) | (first[1] ^ second[1])) != 0;
+    }
+}
+
+FrameEncoder::FrameEncoder( std::size_t t_nb_cells, unsigned t_keyframe_interval )
+    :   m_vegetation(t_nb_cells, 0u),
+        m_fire(t_nb_cells, 0u),
+        m_keyframe_interval(t_keyframe_interval)
+{}
+// --------------------------------------------------------------------------------------------------------------------
+void
+FrameEncoder::add_run( std::uint32_t t_first, std::uint32_t t_length, MapView t_vegetation, MapView t_fire )
+{
+    m_runs.push_back(t_first);
+    m_runs.push_back(t_length);
+    std::memcpy(m_vegetation.data() + t_first, t_vegetation.data() + t_first, t_length);
+    std::memcpy(m_fire.data() + t_first, t_fire.data() + t_first, t_length);
+}
+// --------------------------------------------------------------------------------------------------------------------
+std::size_t
+FrameEncoder::max_frame_size( std::size_t t_nb_cells )
+{
+    // Au plus une plage par bloc, et chaque case une fois
+    return 4*header_words + 8*((t_nb_cells + block_size - 1)/block_size) + 2*t_nb_cells;
+}
+// --------------------------------------------------------------------------------------------------------------------
+std::vector<std::uint8_t> const&
+FrameEncoder::encode( MapView t_vegetation, MapView t_fire )
+{
+    encode(t_vegetation, t_fire, m_frame);
+    return m_frame;
+}
+// --------------------------------------------------------------------------------------------------------------------
+std::size_t
+FrameEncoder::collect_runs( MapView t_vegetation, MapView t_fire )
+{
+    const std::size_t nb_cells = m_vegetation.size();
+    m_keyframe = m_nb_frames == 0 || (m_keyframe_interval > 0 && m_nb_frames % m_keyframe_interval == 0);
+    m_runs.clear();
+    if (m_keyframe)
+    {
+        add_run(0, std::uint32_t(nb_cells), t_vegetation, t_fire);
+    }
+    else
+    {
+        // Blocs modifiés depuis la trame précédente, fusionnés en plages contiguës
+        std::size_t run_start = nb_cells;
+        for (std::size_t first = 0; first < nb_cells; first += block_size)
+        {
+            std::size_t count = std::min(block_size, nb_cells - first);
+            bool changed = differs(t_vegetation.data() + first, m_vegetation.data() + first, count)
+                        || differs(t_fire.data() + first, m_fire.data() + first, count);
+            if (changed && run_start == nb_cells) run_start = first;
+            if (!changed && run_start != nb_cells)
+            {
+                add_run(std::uint32_t(run_start), std::uint32_t(first - run_start), t_vegetation, t_fire);
+                run_start = nb_cells;
+            }
+        }
+        if (run_start != nb_cells)
+            add_run(std::uint32_t(run_start), std::uint32_t(nb_cells - run_start), t_vegetation, t_fire);
+    }
+
+    std::size_t payload = 0;
+    for (std::size_t r = 1; r < m_runs.size(); r += 2) payload += 2*std::size_t(m_runs[r]);
+    return 4*(header_words + m_runs.size()) + payload;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+FrameEncoder::write( std::uint8_t* t_frame, std::size_t t_size )
+{
+    std::uint8_t* out = t_frame;
+    put_word(out,     m_keyframe ? key : delta);
+    put_word(out + 4, std::uint32_t(m_vegetation.size()));
+    put_word(out + 8, std::uint32_t(m_runs.size()/2));
+    out += 4*header_words;
+    for (auto word : m_runs)
+    {
+        put_word(out, word);
+        out += 4;
+    }
+    for (std::size_t r = 0; r < m_runs.size(); r += 2)
+    {
+        std::uint32_t first = m_runs[r], length = m_runs[r+1];
+        std::memcpy(out,          m_vegetation.data() + first, length);
+        std::memcpy(out + length, m_fire.data() + first,       length);
+        out += 2*std::size_t(length);
+    }
+    m_nb_frames += 1;
+    m_encoded_bytes += t_size;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+FrameEncoder::encode( MapView t_vegetation, MapView t_fire, std::vector<std::uint8_t>& t_frame )
+{
+    t_frame.resize(collect_runs(t_vegetation, t_fire));
+    write(t_frame.data(), t_frame.size());
+}
+// --------------------------------------------------------------------------------------------------------------------
+std::size_t
+FrameEncoder::encode( MapView t_vegetation, MapView t_fire, std::uint8_t* t_frame )
+{
+    std::size_t size = collect_runs(t_vegetation, t_fire);
+    write(t_frame, size);
+    return size;
+}
+// ====================================================================================================================
+FrameDecoder::FrameDecoder( std::size_t t_nb_cells )
+    :   m_vegetation(t_nb_cells, 0u),
+        m_fire(t_nb_cells, 0u)
+{}
+// --------------------------------------------------------------------------------------------------------------------
+bool
+FrameDecoder::apply( std::uint8_t const* t_frame, std::size_t t_size )
+{
+    // Première passe : en-tête et plages sont tous vérifiés avant d'écrire dans les cartes, une trame
+    // tronquée ou mal formée laisse donc les cartes intactes. Les tailles sont comparées à ce qui reste
+    // de la trame, sans arithmétique de pointeurs sur des valeurs reçues.
+    const std::size_t nb_cells = m_vegetation.size();
+    if (t_size < 4*header_words) return false;
+    const std::uint32_t kind = get_word(t_frame);
+    if ((kind != FrameEncoder::key && kind != FrameEncoder::delta) || get_word(t_frame + 4) != nb_cells) return false;
+    const std::size_t nb_runs = get_word(t_frame + 8);
+    std::uint8_t const* runs = t_frame + 4*header_words;
+    std::size_t remaining = t_size - 4*header_words;
+    if (nb_runs > remaining/8) return false;
+    remaining -= 8*nb_runs;
+    for (std::size_t r = 0; r < nb_runs; ++r)
+    {
+        std::size_t first = get_word(runs + 8*r), length = get_word(runs + 8*r + 4);
+        if (first > nb_cells || length > nb_cells - first || length > remaining/2) return false;
+        remaining -= 2*length;
+    }
+    if (remaining != 0) return false;
+
+    // Seconde passe : application des plages validées
+    std::uint8_t const* payload = runs + 8*nb_runs;
+    for (std::size_t r = 0; r < nb_runs; ++r)
+    {
+        std::size_t first = get_word(runs + 8*r), length = get_word(runs + 8*r + 4);
+        std::memcpy(m_vegetation.data() + first, payload,          length);
+        std::memcpy(m_fire.data() + first,       payload + length, length);
+        payload += 2*length;
+    }
+    return true;
+}
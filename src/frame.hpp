@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "map_view.hpp"
+
+/**
+ * @brief Trames des cartes (végétation, feu) envoyées du processus de calcul au processus d'affichage.
+ *
+ * D'un pas à l'autre, seules les cases du front et leurs voisines changent. Une trame delta ne
+ * contient donc que les plages de cases modifiées depuis la trame précédente, repérées par blocs de
+ * block_size cases ; son volume est proportionnel au front, et non à la surface de la carte. Une
+ * trame clé, qui contient toute la carte, part périodiquement et au premier envoi.
+ *
+ * Le codeur compare toute la carte à celle de la trame précédente : ce coût reste proportionnel à la
+ * surface. Ne comparer que les lignes modifiées demanderait la plage des lignes touchées par le modèle
+ * depuis la trame précédente, que les MapView ne transportent pas.
+ *
+ * Format (mots de 32 bits puis octets) : type, nombre de cases, nombre de plages, puis les plages
+ * {première case, longueur}, puis pour chaque plage ses octets de végétation et ses octets de feu.
+ */
+class FrameEncoder
+{
+public:
+    enum Kind : std::uint32_t { key = 0, delta = 1 };
+    static constexpr std::size_t block_size = 16;
+
+    // Une trame clé toutes les t_keyframe_interval trames (0 : seulement la première)
+    FrameEncoder( std::size_t t_nb_cells, unsigned t_keyframe_interval = 64 );
+
+    // Trame des cartes courantes, dans un tampon réutilisé d'un appel à l'autre
+    std::vector<std::uint8_t> const& encode( MapView t_vegetation, MapView t_fire );
+    // Idem dans le tampon t_frame, redimensionné si besoin (jamais au-delà de max_frame_size())
+    void encode( MapView t_vegetation, MapView t_fire, std::vector<std::uint8_t>& t_frame );
+    // Idem dans t_frame, d'au moins max_frame_size() octets ; renvoie la taille de la trame
+    std::size_t encode( MapView t_vegetation, MapView t_fire, std::uint8_t* t_frame );
+    // Taille maximale d'une trame de cartes de t_nb_cells cases
+    static std::size_t max_frame_size( std::size_t t_nb_cells );
+
+    std::size_t   nb_frames() const { return m_nb_frames; }
+    std::uint64_t encoded_bytes() const { return m_encoded_bytes; }  // Volume cumulé des trames
+
+private:
+    void add_run( std::uint32_t t_first, std::uint32_t t_length, MapView t_vegetation, MapView t_fire );
+    // Plages de la trame suivante ; renvoie sa taille
+    std::size_t collect_runs( MapView t_vegetation, MapView t_fire );
+    void write( std::uint8_t* t_frame, std::size_t t_size );
+
+    std::vector<std::uint8_t> m_vegetation, m_fire;  // Cartes de la trame précédente
+    std::vector<std::uint32_t> m_runs;               // Plages de la trame en cours {première case, longueur}
+    bool m_keyframe = false;                         // La trame en cours est une trame clé
+    std::vector<std::uint8_t> m_frame;
+    unsigned m_keyframe_interval;
+    std::size_t m_nb_frames = 0;
+    std::uint64_t m_encoded_bytes = 0;
+};
+
+/**
+ * @brief Côté affichage : applique les trames reçues sur des cartes persistantes.
+ */
+class FrameDecoder
+{
+public:
+    explicit FrameDecoder( std::size_t t_nb_cells );
+
+    // Renvoie faux si la trame est mal formée ou ne correspond pas à la taille des cartes ; les cartes
+    // ne sont alors pas modifiées
+    bool apply( std::uint8_t const* t_frame, std::size_t t_size );
+
+    MapView vegetation() const { return m_vegetation; }
+    MapView fire() const { return m_fire; }
+
+private:
+    std::vector<std::uint8_t> m_vegetation, m_fire;
+};
@@ -0,0 +1,44 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include "frame_sink.hpp"
+
+SnapshotSink::SnapshotSink( std::string t_prefix, unsigned t_interval, unsigned t_width, unsigned t_height )
+    :   m_prefix(std::move(t_prefix)),
+        m_interval(t_interval > 0 ? t_interval : 1),
+        m_width(t_width),
+        m_height(t_height),
+        m_pixels(std::size_t(t_width)*t_height),
+        m_rgb(3*std::size_t(t_width)*t_height)
+{}
+// --------------------------------------------------------------------------------------------------------------------
+void
+SnapshotSink::write( std::uint64_t t_step, MapView t_vegetation, MapView t_fire, bool t_last )
+{
+    // Des trames peuvent manquer (trames sautées à l'envoi) : l'image est prise à la première trame
+    // qui atteint ou dépasse le pas prévu
+    if ((t_step < m_next_step && !t_last) || t_step == m_last_step) return;
+    m_next_step = t_step - t_step % m_interval + m_interval;
+    m_last_step = t_step;
+
+    m_colors.convert(t_vegetation.data(), t_fire.data(), m_width, m_height, m_width,
+                     m_pixels.data(), m_width*sizeof(std::uint32_t));
+    for (std::size_t i = 0; i < m_pixels.size(); ++i)
+    {
+        m_rgb[3*i+0] = std::uint8_t(m_pixels[i] >> 16);
+        m_rgb[3*i+1] = std::uint8_t(m_pixels[i] >> 8);
+        m_rgb[3*i+2] = std::uint8_t(m_pixels[i]);
+    }
+
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), "_%06llu.ppm", static_cast<unsigned long long>(t_step));
+    std::ofstream file(m_prefix + suffix, std::ios::binary);
+    file << "P6\n" << m_width << " " << m_height << "\n255\n";
+    file.write(reinterpret_cast<char const*>(m_rgb.data()), std::streamsize(m_rgb.size()));
+    if (!file)
+    {
+        std::cerr << "[ERREUR] Écriture impossible : " << m_prefix + suffix << std::endl;
+        return;
+    }
+    m_written += 1;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "map_view.hpp"
+#include "color_map.hpp"
+
+/**
+ * @brief Destination des trames produites par le calcul : fenêtre, fichiers d'images, ...
+ *
+ * Le processus qui reçoit les trames les transmet à chacune de ses destinations sans connaître leur
+ * nature ; sans destination, le calcul tourne seul, à pleine vitesse. Une destination choisit les
+ * trames qu'elle traite (cadence d'affichage, intervalle entre images) mais traite toujours la
+ * dernière, qui porte l'état final du calcul.
+ */
+class FrameSink
+{
+public:
+    virtual ~FrameSink() = default;
+
+    // Trame du pas t_step, cartes de la grille entière ; t_last : dernière trame du calcul
+    virtual void write( std::uint64_t t_step, MapView t_vegetation, MapView t_fire, bool t_last ) = 0;
+    // Traitement entre deux trames (événements d'une fenêtre, ...) ; renvoie vrai si l'arrêt du calcul
+    // est demandé
+    virtual bool poll() { return false; }
+    // Nombre de trames effectivement traitées
+    virtual std::size_t written() const = 0;
+};
+
+/**
+ * @brief Images périodiques de la grille, au format PPM binaire (P6), sans dépendance graphique.
+ *
+ * Une image tous les t_interval pas au moins (prefix_000120.ppm, ...), plus celle de l'état final.
+ * Les couleurs sont celles de l'affichage (ColorMap). Les tampons de conversion sont alloués une fois.
+ */
+class SnapshotSink : public FrameSink
+{
+public:
+    SnapshotSink( std::string t_prefix, unsigned t_interval, unsigned t_width, unsigned t_height );
+
+    void write( std::uint64_t t_step, MapView t_vegetation, MapView t_fire, bool t_last ) override;
+    std::size_t written() const override { return m_written; }
+
+private:
+    std::string m_prefix;
+    unsigned m_interval, m_width, m_height;
+    std::uint64_t m_next_step = 0;      // Premier pas de la prochaine image
+    std::uint64_t m_last_step = ~std::uint64_t(0);
+    std::size_t m_written = 0;
+    ColorMap m_colors;
+    std::vector<std::uint32_t> m_pixels; // Pixels ARGB8888 de l'image
+    std::vector<std::uint8_t> m_rgb;     // Pixels RGB du fichier
+};
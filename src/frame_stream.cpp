@@ -0,0 +1,61 @@
+#include <iostream>
+#include "frame_stream.hpp"
+#include "frame_sink.hpp"
+
+FrameSender::FrameSender( MPI_Comm t_comm, int t_destination, int t_tag, std::size_t t_nb_cells,
+                          unsigned t_keyframe_interval )
+    :   m_channel(t_comm, t_destination, t_tag, FrameEncoder::max_frame_size(t_nb_cells)),
+        m_encoder(t_nb_cells, t_keyframe_interval)
+{}
+// --------------------------------------------------------------------------------------------------------------------
+FrameSender::~FrameSender()
+{
+    flush();
+}
+// --------------------------------------------------------------------------------------------------------------------
+bool
+FrameSender::send( StepHeader t_header, MapView t_vegetation, MapView t_fire )
+{
+    std::uint8_t* payload = m_channel.acquire();
+    if (payload == nullptr)
+    {
+        m_skipped += 1;
+        return false;
+    }
+    // La trame est codée directement dans le tampon enregistré du canal
+    t_header.payload = StepHeader::frame;
+    t_header.payload_size = std::uint32_t(m_encoder.encode(t_vegetation, t_fire, payload));
+    m_channel.start(t_header);
+    return true;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+FrameSender::flush()
+{
+    m_channel.flush();
+}
+// ====================================================================================================================
+FrameReceiver::FrameReceiver( MPI_Comm t_comm, int t_source, int t_tag, std::size_t t_nb_cells )
+    :   m_channel(t_comm, t_source, t_tag, FrameEncoder::max_frame_size(t_nb_cells)),
+        m_decoder(t_nb_cells)
+{}
+// --------------------------------------------------------------------------------------------------------------------
+std::size_t
+FrameReceiver::poll( FrameSink* t_every )
+{
+    std::size_t nb_applied = 0;
+    StepHeader header;
+    std::uint8_t const* payload;
+    while (!m_finished && m_channel.next(header, payload))
+    {
+        if (header.payload == StepHeader::frame && !m_decoder.apply(payload, header.payload_size))
+            std::cerr << "[ERREUR] Trame invalide." << std::endl;
+        m_channel.release();
+        m_header = header;
+        m_finished = header.running == 0;
+        if (t_every) t_every->write(header.step, m_decoder.vegetation(), m_decoder.fire(), m_finished);
+        m_received += 1;
+        nb_applied += 1;
+    }
+    return nb_applied;
+}
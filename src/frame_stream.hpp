@@ -0,0 +1,77 @@
+#pragma once
+#include <mpi.h>
+#include <cstdint>
+#include "frame.hpp"
+#include "channel.hpp"
+
+class FrameSink;
+
+/**
+ * @brief Envoi non bloquant des trames : le calcul n'attend jamais l'affichage.
+ *
+ * Chaque pas part en un seul message sur un canal persistant (SendChannel) : l'état du calcul dans
+ * l'en-tête, la trame en charge utile. Deux tampons d'envoi : une trame part dès que l'un d'eux est
+ * libre. Si les deux sont encore en cours d'envoi, la trame est sautée. La suivante est codée par
+ * rapport à la dernière trame envoyée et contient donc aussi les changements de la trame sautée :
+ * l'affichage ne perd aucune case, il reçoit seulement moins d'images.
+ */
+class FrameSender
+{
+public:
+    FrameSender( MPI_Comm t_comm, int t_destination, int t_tag, std::size_t t_nb_cells,
+                 unsigned t_keyframe_interval = 64 );
+    FrameSender( FrameSender const & ) = delete;
+    ~FrameSender();
+
+    FrameSender& operator = ( FrameSender const & ) = delete;
+
+    // Envoie l'état t_header et les cartes si un tampon est libre ; renvoie faux si la trame est sautée.
+    // Le dernier message (t_header.running nul) ne doit pas être sauté : flush() le précède.
+    bool send( StepHeader t_header, MapView t_vegetation, MapView t_fire );
+    // Attend la fin des envois en cours
+    void flush();
+
+    std::size_t   sent() const { return m_encoder.nb_frames(); }
+    std::size_t   skipped() const { return m_skipped; }
+    std::uint64_t sent_bytes() const { return m_encoder.encoded_bytes(); }
+
+private:
+    SendChannel m_channel;
+    FrameEncoder m_encoder;
+    std::size_t m_skipped = 0;
+};
+
+/**
+ * @brief Réception des trames côté affichage, sans attente.
+ *
+ * Deux réceptions persistantes restent postées en permanence, le transfert progresse donc pendant
+ * que l'affichage dessine. poll() applique dans l'ordre toutes les trames arrivées : les cartes et
+ * l'état du calcul sont alors ceux du message le plus récent. Une destination qui doit voir chaque
+ * trame (enregistrement) est passée à poll(), qui la lui transmet dès qu'elle est appliquée.
+ */
+class FrameReceiver
+{
+public:
+    FrameReceiver( MPI_Comm t_comm, int t_source, int t_tag, std::size_t t_nb_cells );
+    FrameReceiver( FrameReceiver const & ) = delete;
+    ~FrameReceiver() = default;
+
+    FrameReceiver& operator = ( FrameReceiver const & ) = delete;
+
+    // Applique les trames arrivées, transmises une à une à t_every s'il n'est pas nul ; renvoie leur nombre
+    std::size_t poll( FrameSink* t_every = nullptr );
+
+    std::size_t received() const { return m_received; }
+    // Dernier message du calcul reçu : plus rien ne suit
+    bool        finished() const { return m_finished; }
+    StepHeader const& header() const { return m_header; }  // État du calcul au dernier message
+    MapView     vegetation() const { return m_decoder.vegetation(); }
+    MapView     fire() const { return m_decoder.fire(); }
+
+private:
+    ReceiveChannel m_channel;
+    FrameDecoder m_decoder;
+    StepHeader m_header;
+    std::size_t m_received = 0;
+    bool m_finished = false;
+};
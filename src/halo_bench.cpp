@@ -0,0 +1,80 @@
+#include <mpi.h>
+#include <cmath>
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include "distributed_model.hpp"
+
+// Mesure de passage à l'échelle faible de l'échange des bords : chaque processus garde un bloc
+// d'environ side x side cases, la grille grandit avec le nombre de processus. On compare le
+// découpage en bandes de lignes (grille P x 1) au découpage en blocs choisi automatiquement.
+// En bandes, chaque processus échange deux lignes de toute la largeur, qui croît comme sqrt(P) ;
+// en blocs, le volume échangé par processus reste de l'ordre de 4 x side. Chaque découpage est
+// mesuré avec un échange bloquant, puis recouvert par l'évolution des cases intérieures : le temps
+// d'échange est alors celui passé à attendre les fantômes.
+
+struct BenchResult {
+    std::array<int,2> dims;
+    double halo_bytes_per_step;  // Maximum sur les processus
+    double halo_ms_per_step;     // Maximum sur les processus
+    double interior_ms_per_step; // Maximum sur les processus
+    double border_ms_per_step;   // Maximum sur les processus
+    double step_ms;
+};
+
+BenchResult run(unsigned discretization, std::array<int,2> dims, bool overlap, int nb_steps) {
+    Model::LexicoIndices start{discretization/2, discretization/2};
+    DistributedModel simu(MPI_COMM_WORLD, 1., discretization, {1., 0.}, start, 60., 0, dims);
+    simu.local().set_threads(1);
+    simu.set_overlap(overlap);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double begin = MPI_Wtime();
+    for (int step = 0; step < nb_steps; ++step)
+        simu.update();
+    double elapsed = MPI_Wtime() - begin;
+
+    double local[4] = {double(simu.halo_bytes())/nb_steps, 1000.*simu.halo_seconds()/nb_steps,
+                       1000.*simu.interior_seconds()/nb_steps, 1000.*simu.border_seconds()/nb_steps};
+    double global[4];
+    MPI_Reduce(local, global, 4, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    return {simu.dims(), global[0], global[1], global[2], global[3], 1000.*elapsed/nb_steps};
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    unsigned side = 512;
+    int nb_steps = 200;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--side" && i + 1 < argc) side = std::stoul(argv[++i]);
+        else if (arg == "--steps" && i + 1 < argc) nb_steps = std::stoi(argv[++i]);
+    }
+    unsigned discretization = unsigned(std::lround(side*std::sqrt(double(size))));
+
+    std::pair<char const*, BenchResult> results[] = {
+        {"bandes bloquant ", run(discretization, {size, 1}, false, nb_steps)},
+        {"bandes recouvert", run(discretization, {size, 1}, true,  nb_steps)},
+        {"blocs  bloquant ", run(discretization, {0, 0},    false, nb_steps)},
+        {"blocs  recouvert", run(discretization, {0, 0},    true,  nb_steps)}};
+
+    if (rank == 0) {
+        std::cout << "Processus : " << size << " - grille : " << discretization << "x" << discretization
+                  << " - pas : " << nb_steps << std::endl;
+        for (auto const& [name, result] : results) {
+            std::cout << "  " << name << " " << result.dims[0] << "x" << result.dims[1]
+                      << " : bords " << std::fixed << std::setprecision(0) << result.halo_bytes_per_step
+                      << " octets/pas/processus, échange " << std::setprecision(3) << result.halo_ms_per_step
+                      << " ms/pas, intérieur " << result.interior_ms_per_step
+                      << " ms/pas, bord " << result.border_ms_per_step
+                      << " ms/pas, pas complet " << result.step_ms << " ms" << std::endl;
+        }
+    }
+
+    MPI_Finalize();
+    return EXIT_SUCCESS;
+}
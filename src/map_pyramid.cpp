@@ -0,0 +1,64 @@
+#include <algorithm>
+#include "map_pyramid.hpp"
+
+namespace
+{
+    // Au-delà de ce nombre de cases produites, les lignes d'un niveau sont réparties entre threads
+    constexpr std::size_t parallel_cells = 1u << 16;
+}
+
+unsigned
+MapPyramid::level_for( unsigned t_width, unsigned t_height, unsigned t_max_width, unsigned t_max_height )
+{
+    unsigned level = 0;
+    while ((t_width > t_max_width || t_height > t_max_height) && (t_width > 1 || t_height > 1))
+    {
+        t_width  = (t_width  + 1)/2;
+        t_height = (t_height + 1)/2;
+        level += 1;
+    }
+    return level;
+}
+// --------------------------------------------------------------------------------------------------------------------
+MapPyramid::Level
+MapPyramid::reduce( Level t_region, unsigned t_level )
+{
+    if (m_vegetation.size() < t_level)
+    {
+        m_vegetation.resize(t_level);
+        m_fire.resize(t_level);
+    }
+    Level source = t_region;
+    for (unsigned level = 0; level < t_level; ++level)
+    {
+        const unsigned width = (source.width + 1)/2, height = (source.height + 1)/2;
+        auto& vegetation = m_vegetation[level];
+        auto& fire = m_fire[level];
+        vegetation.resize(std::size_t(width)*height);
+        fire.resize(std::size_t(width)*height);
+
+        // Sur un bord de largeur ou de hauteur impaire, la dernière ligne (colonne) est dupliquée :
+        // maximum et moyenne portent alors sur les seules cases existantes
+        const std::size_t stride = source.stride;
+#pragma omp parallel for schedule(static) if(std::size_t(width)*height >= parallel_cells)
+        for (int row = 0; row < int(height); ++row)
+        {
+            const std::size_t top = std::size_t(2*row)*stride;
+            const std::size_t bottom = std::size_t(std::min(2*unsigned(row) + 1, source.height - 1))*stride;
+            std::uint8_t* out_vegetation = vegetation.data() + std::size_t(row)*width;
+            std::uint8_t* out_fire = fire.data() + std::size_t(row)*width;
+            for (unsigned column = 0; column < width; ++column)
+            {
+                const std::size_t left = 2*column, right = std::min(2*column + 1, source.width - 1);
+                std::uint8_t const* f = source.fire;
+                std::uint8_t const* v = source.vegetation;
+                out_fire[column] = std::max(std::max(f[top + left], f[top + right]),
+                                            std::max(f[bottom + left], f[bottom + right]));
+                out_vegetation[column] = std::uint8_t((unsigned(v[top + left]) + v[top + right]
+                                                       + v[bottom + left] + v[bottom + right] + 2)/4);
+            }
+        }
+        source = {vegetation.data(), fire.data(), width, height, width};
+    }
+    return source;
+}
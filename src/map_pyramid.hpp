@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Pyramide de réduction des cartes pour l'affichage des grilles plus grandes que la fenêtre.
+ *
+ * Chaque niveau divise par deux la largeur et la hauteur du précédent : une case du niveau k + 1
+ * résume un carré de 2 x 2 cases du niveau k, par l'intensité maximale du feu (un foyer reste
+ * visible à toute échelle) et la densité moyenne de la végétation. Seule la région affichée est
+ * réduite, et seulement jusqu'au niveau demandé ; les tampons sont réutilisés d'une image à l'autre.
+ */
+class MapPyramid
+{
+public:
+    // Région de cartes d'octets, lignes espacées de stride cases
+    struct Level
+    {
+        std::uint8_t const* vegetation;
+        std::uint8_t const* fire;
+        unsigned width, height;
+        std::size_t stride;
+    };
+
+    // Plus petit niveau auquel une région de t_width x t_height cases tient dans t_max_width x t_max_height pixels
+    static unsigned level_for( unsigned t_width, unsigned t_height, unsigned t_max_width, unsigned t_max_height );
+
+    // Réduit la région t_region jusqu'au niveau t_level (0 : la région elle-même, sans copie).
+    // Le niveau rendu reste valide jusqu'à l'appel suivant.
+    Level reduce( Level t_region, unsigned t_level );
+
+private:
+    std::vector<std::vector<std::uint8_t>> m_vegetation, m_fire;  // Niveaux 1, 2, ...
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Vue en lecture seule sur une carte d'octets contiguë (végétation, feu), sans copie.
+ *
+ * La vue ne possède pas les données : elle reste valide tant que la carte observée n'est ni
+ * détruite ni réallouée (Model::set_domain, par exemple). Les données peuvent être envoyées
+ * (MPI_Send) ou affichées en place ; copy() en fait une copie explicite.
+ */
+class MapView
+{
+public:
+    MapView() = default;
+    MapView( std::uint8_t const* t_data, std::size_t t_size )
+        :   m_data(t_data), m_size(t_size)
+    {}
+    MapView( std::vector<std::uint8_t> const& t_map )
+        :   m_data(t_map.data()), m_size(t_map.size())
+    {}
+
+    std::uint8_t const* data () const { return m_data; }
+    std::size_t         size () const { return m_size; }
+    bool                empty() const { return m_size == 0; }
+    std::uint8_t operator [] ( std::size_t t_index ) const { return m_data[t_index]; }
+    std::uint8_t const* begin() const { return m_data; }
+    std::uint8_t const* end  () const { return m_data + m_size; }
+
+    std::vector<std::uint8_t> copy() const { return {m_data, m_data + m_size}; }
+
+private:
+    std::uint8_t const* m_data = nullptr;
+    std::size_t         m_size = 0;
+};
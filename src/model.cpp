@@ -1,18 +1,15 @@
 #include <stdexcept>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 #include "model.hpp"
 
 
 namespace
 {
-    double pseudo_random( std::size_t index, std::size_t time_step )
-    {
-        std::uint_fast32_t xi = std::uint_fast32_t(index*(time_step+1));
-        std::uint_fast32_t r  = (48271*xi)%2147483647;
-        return r/2147483646.;
-    }
-
     double log_factor( std::uint8_t value )
     {
         return std::log(1.+value)/std::log(256);
@@ -20,136 +17,509 @@ namespace
 }
 
 Model::Model( double t_length, unsigned t_discretization, std::array<double,2> t_wind,
-              LexicoIndices t_start_fire_position, double t_max_wind )
+              LexicoIndices t_start_fire_position, double t_max_wind, std::uint64_t t_seed )
+    :   Model(t_length, t_discretization, t_wind, t_start_fire_position, Domain{0u, t_discretization, 0u, t_discretization},
+              t_max_wind, t_seed)
+{}
+// --------------------------------------------------------------------------------------------------------------------
+Model::Model( double t_length, unsigned t_discretization, std::array<double,2> t_wind,
+              LexicoIndices t_start_fire_position, Domain t_domain, double t_max_wind, std::uint64_t t_seed )
     :   m_length(t_length),
         m_distance(-1),
         m_geometry(t_discretization),
+        m_first_row(t_domain.first_row),
+        m_rows(t_domain.nb_rows),
+        m_first_column(t_domain.first_column),
+        m_columns(t_domain.nb_columns),
         m_wind(t_wind),
         m_wind_speed(std::sqrt(t_wind[0]*t_wind[0] + t_wind[1]*t_wind[1])),
         m_max_wind(t_max_wind),
-        m_vegetation_map(t_discretization*t_discretization, 255u),
-        m_fire_map(t_discretization*t_discretization, 0u)
+        m_rng(t_seed),
+        m_vegetation_map(std::size_t(t_domain.nb_rows)*t_domain.nb_columns, 255u),
+        m_fire_map(std::size_t(t_domain.nb_rows)*t_domain.nb_columns, 0u),
+        m_fire_front(std::size_t(t_domain.nb_rows)*t_domain.nb_columns, t_domain.nb_columns),
+        m_next_front(std::size_t(t_domain.nb_rows)*t_domain.nb_columns, t_domain.nb_columns),
+        m_halo_west(t_domain.nb_rows, 0u),
+        m_halo_east(t_domain.nb_rows, 0u),
+#if defined(_OPENMP)
+        m_nb_threads(unsigned(omp_get_max_threads()))
+#else
+        m_nb_threads(1)
+#endif
 {
     if (t_discretization == 0)
     {
         throw std::range_error("Le nombre de cases par direction doit être plus grand que zéro.");
     }
+    if (t_domain.nb_rows == 0 || t_domain.first_row + t_domain.nb_rows > t_discretization ||
+        t_domain.nb_columns == 0 || t_domain.first_column + t_domain.nb_columns > t_discretization)
+    {
+        throw std::range_error("Le sous-domaine doit être un bloc non vide de la grille.");
+    }
     m_distance = m_length/double(m_geometry);
-    auto index = get_index_from_lexicographic_indices(t_start_fire_position);
-    m_fire_map[index] = 255u;
-    m_fire_front[index] = 255u;
+    start_fire(t_start_fire_position);
+    set_wind(t_wind);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::reset( std::array<double,2> t_wind, LexicoIndices t_start_fire_position, std::uint64_t t_seed )
+{
+    // Même état qu'un modèle construit avec ces paramètres, dans les tableaux déjà alloués (et déjà
+    // touchés : ni allocation ni défaut de page). Le sous-domaine, le moteur et les threads sont conservés.
+    m_time_step = 0;
+    m_rng = CounterRng(t_seed);
+    // Hors des lignes touchées par le feu, les cartes sont restées dans leur état initial : le coût est
+    // proportionnel à la surface parcourue par la simulation précédente, pas à celle de la grille
+    if (m_touched_rows[0] < m_touched_rows[1])
+    {
+        const std::size_t first = std::size_t(m_touched_rows[0])*m_columns, end = std::size_t(m_touched_rows[1])*m_columns;
+        std::fill(m_vegetation_map.begin() + first, m_vegetation_map.begin() + end, std::uint8_t(255u));
+        std::fill(m_fire_map.begin() + first, m_fire_map.begin() + end, std::uint8_t(0u));
+    }
+    m_touched_rows = {~0u, 0u};
+    m_fire_front.reset();
+    m_next_front.reset();
+    std::fill(m_halo_west.begin(), m_halo_west.end(), std::uint8_t(0u));
+    std::fill(m_halo_east.begin(), m_halo_east.end(), std::uint8_t(0u));
+    start_fire(t_start_fire_position);
+    set_wind(t_wind);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::start_fire( LexicoIndices t_start_fire_position )
+{
+    // Le foyer initial n'est allumé que par le sous-domaine qui le contient
+    if (t_start_fire_position.row    >= m_first_row    && t_start_fire_position.row    < m_first_row + m_rows &&
+        t_start_fire_position.column >= m_first_column && t_start_fire_position.column < m_first_column + m_columns)
+    {
+        auto index = get_index_from_lexicographic_indices(t_start_fire_position);
+        m_fire_map[index] = 255u;
+        touch_rows(t_start_fire_position.row - m_first_row, t_start_fire_position.row - m_first_row + 1);
+        m_fire_front.insert(index, 255u);
+        m_fire_front.compact();
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::set_wind( std::array<double,2> t_wind )
+{
+    m_wind = t_wind;
+    m_wind_speed = std::sqrt(t_wind[0]*t_wind[0] + t_wind[1]*t_wind[1]);
 
     constexpr double alpha0 = 4.52790762e-01;
     constexpr double alpha1 = 9.58264437e-04;
     constexpr double alpha2 = 3.61499382e-05;
 
-    if (m_wind_speed < t_max_wind)
+    if (m_wind_speed < m_max_wind)
         p1 = alpha0 + alpha1*m_wind_speed + alpha2*(m_wind_speed*m_wind_speed);
     else 
-        p1 = alpha0 + alpha1*t_max_wind + alpha2*(t_max_wind*t_max_wind);
+        p1 = alpha0 + alpha1*m_max_wind + alpha2*(m_max_wind*m_max_wind);
     p2 = 0.3;
 
     if (m_wind[0] > 0)
     {
-        alphaEastWest = std::abs(m_wind[0]/t_max_wind)+1;
-        alphaWestEast = 1.-std::abs(m_wind[0]/t_max_wind);    
+        alphaEastWest = std::abs(m_wind[0]/m_max_wind)+1;
+        alphaWestEast = 1.-std::abs(m_wind[0]/m_max_wind);    
     }
     else
     {
-        alphaWestEast = std::abs(m_wind[0]/t_max_wind)+1;
-        alphaEastWest = 1. - std::abs(m_wind[0]/t_max_wind);
+        alphaWestEast = std::abs(m_wind[0]/m_max_wind)+1;
+        alphaEastWest = 1. - std::abs(m_wind[0]/m_max_wind);
     }
 
     if (m_wind[1] > 0)
     {
-        alphaSouthNorth = std::abs(m_wind[1]/t_max_wind) + 1;
-        alphaNorthSouth = 1. - std::abs(m_wind[1]/t_max_wind);
+        alphaSouthNorth = std::abs(m_wind[1]/m_max_wind) + 1;
+        alphaNorthSouth = 1. - std::abs(m_wind[1]/m_max_wind);
     }
     else
     {
-        alphaNorthSouth = std::abs(m_wind[1]/t_max_wind) + 1;
-        alphaSouthNorth = 1. - std::abs(m_wind[1]/t_max_wind);
+        alphaNorthSouth = std::abs(m_wind[1]/m_max_wind) + 1;
+        alphaSouthNorth = 1. - std::abs(m_wind[1]/m_max_wind);
     }
+    build_ignition_tables();
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::set_domain( Domain t_domain, std::uint8_t const* t_vegetation, std::uint8_t const* t_fire,
+                   std::uint8_t const* t_intensity )
+{
+    if (t_domain.nb_rows == 0 || t_domain.first_row + t_domain.nb_rows > m_geometry ||
+        t_domain.nb_columns == 0 || t_domain.first_column + t_domain.nb_columns > m_geometry)
+    {
+        throw std::range_error("Le sous-domaine doit être un bloc non vide de la grille.");
+    }
+    m_first_row    = t_domain.first_row;
+    m_rows         = t_domain.nb_rows;
+    m_first_column = t_domain.first_column;
+    m_columns      = t_domain.nb_columns;
+    const std::size_t nb_cells = std::size_t(m_rows)*m_columns;
+    m_vegetation_map.assign(t_vegetation, t_vegetation + nb_cells);
+    m_fire_map.assign(t_fire, t_fire + nb_cells);
+    m_fire_front = FireFront(nb_cells, m_columns);
+    m_next_front = FireFront(nb_cells, m_columns);
+    // Cases insérées dans l'ordre croissant : compact() n'a rien à trier
+    for (std::size_t index = 0; index < nb_cells; ++index)
+        if (t_intensity[index] != 0) m_fire_front.insert(index, t_intensity[index]);
+    m_fire_front.compact();
+    m_halo_west.assign(m_rows, 0u);
+    m_halo_east.assign(m_rows, 0u);
+    m_touched_rows = {0u, m_rows};
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::build_ignition_tables()
+{
+    // Probabilité d'allumage = alpha*p1*log_factor(source)*log_factor(végétation), approchée en virgule fixe :
+    // les deux facteurs en Q15 donnent un seuil en Q30, comparé aux 30 bits de poids fort d'un tirage.
+    // alpha croît sans borne avec le vent : le produit est calculé sur 64 bits et un seuil d'au moins 2^30
+    // allume toujours (probabilité saturée à 1, comme avec la formule en flottants). Le premier facteur est
+    // borné à 64 : log_factor(végétation) vaut au moins 1/8 hors végétation nulle, au-delà la probabilité
+    // est de toute façon saturée. Les deux moteurs utilisent les mêmes tables.
+    std::array<double,4> alphas = {alphaSouthNorth, alphaNorthSouth, alphaEastWest, alphaWestEast};
+    for (std::size_t d = 0; d < alphas.size(); ++d)
+        for (unsigned value = 0; value < 256; ++value)
+            m_ignition_coef[d][value] = std::uint32_t(std::clamp(alphas[d]*p1*log_factor(value), 0., 64.)*32768.);
+    for (unsigned value = 0; value < 256; ++value)
+        m_green_coef[value] = std::uint32_t(log_factor(value)*32768.);
+    m_extinction_threshold = std::uint32_t(p2*1073741824.);
 }
 // --------------------------------------------------------------------------------------------------------------------
 bool 
 Model::update()
 {
-    auto next_front = m_fire_front;
-    for (auto f : m_fire_front)
+    update_interior();
+    return update_border();
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::update_interior()
+{
+    // Le front du pas suivant est un tampon persistant : seules les cases listées au pas
+    // précédent sont remises à zéro, sans copie ni allocation.
+    m_next_front.clear();
+    if (m_engine == Engine::dense) dense_interior();
+    else                           sparse_interior();
+}
+// --------------------------------------------------------------------------------------------------------------------
+bool
+Model::update_border()
+{
+    const unsigned nb_bands = unsigned(m_band_rows.size() - 1);
+#pragma omp parallel num_threads(nb_bands) if(nb_bands > 1)
     {
-        // Récupération de la coordonnée lexicographique de la case en feu :
-        LexicoIndices coord = get_lexicographic_from_index(f.first);
-        // Et de la puissance du foyer
-        double power = log_factor(f.second);
+#pragma omp for schedule(static)
+        for (unsigned band = 0; band < nb_bands; ++band)
+        {
+            if (m_engine == Engine::dense) sweep_border(band);
+            else                           burn_border(band);
+        }
+#pragma omp single
+        reserve_front(nb_bands);
+#pragma omp for schedule(static)
+        for (unsigned band = 0; band < nb_bands; ++band)
+            place_band(band);
+    }
+    m_fire_front.swap(m_next_front);
+    // Seules les cases du front (triées) ont pu changer d'état pendant le pas
+    if (!m_fire_front.empty())
+        touch_rows(unsigned(m_fire_front.indices()[0]/m_columns),
+                   unsigned(m_fire_front.indices()[m_fire_front.size()-1]/m_columns) + 1);
+    m_time_step += 1;
+    return !m_fire_front.empty();
+}
+// --------------------------------------------------------------------------------------------------------------------
+unsigned
+Model::partition_front()
+{
+    // Découpage en bandes de lignes portant chacune à peu près autant de cases du front.
+    // En deçà de min_band_cells cases par bande, la synchronisation coûte plus qu'elle ne rapporte.
+    constexpr std::size_t min_band_cells = 4096;
+    const std::size_t size = m_fire_front.size();
+    unsigned nb_bands = unsigned(std::min<std::size_t>({m_nb_threads, size/min_band_cells, m_rows}));
+    nb_bands = std::max(nb_bands, 1u);
+    if (m_bands.size() < nb_bands) m_bands.resize(nb_bands);
+    m_band_rows.resize(nb_bands + 1);
+    m_band_cells.resize(nb_bands + 1);
 
-        // On va tester les cases voisines pour contamination par le feu :
-        // Test des quatre directions (Nord, Sud, Est, Ouest)
-        std::array<std::pair<int, double>, 4> directions = {
-            std::make_pair(m_geometry, alphaSouthNorth),    // Sud
-            std::make_pair(-m_geometry, alphaNorthSouth),   // Nord
-            std::make_pair(1, alphaEastWest),              // Est
-            std::make_pair(-1, alphaWestEast)              // Ouest
-        };
+    // Bornes en lignes strictement croissantes : chaque bande possède au moins une ligne
+    m_band_rows[0] = 0;
+    m_band_rows[nb_bands] = m_rows;
+    for (unsigned band = 1; band < nb_bands; ++band)
+    {
+        unsigned row = unsigned(m_fire_front[band*size/nb_bands].index/m_columns);
+        row = std::max(row, m_band_rows[band-1] + 1);
+        m_band_rows[band] = std::min(row, m_rows - (nb_bands - band));
+    }
+    // Le front étant trié, les cases d'une bande sont contiguës dans le tableau des cases actives
+    std::uint32_t const* cells = m_fire_front.indices();
+    for (unsigned band = 0; band <= nb_bands; ++band)
+        m_band_cells[band] = std::size_t(std::lower_bound(cells, cells + size,
+                                                          std::uint32_t(m_band_rows[band]*m_columns)) - cells);
+    return nb_bands;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::ignite( std::size_t t_target, BandBuffers& t_buffers )
+{
+    if (!m_next_front.contains(t_target))
+    {
+        m_next_front.mark(t_target, 255u);
+        if (!m_fire_front.contains(t_target))
+            t_buffers.ignited.push_back(std::uint32_t(t_target));
+    }
+    m_fire_map[t_target] = 255u;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::reserve_front( unsigned t_nb_bands )
+{
+    std::size_t total = 0;
+    for (unsigned band = 0; band < t_nb_bands; ++band)
+    {
+        m_bands[band].offset = total;
+        total += m_bands[band].cells.size() + m_bands[band].ignited.size() + m_bands[band].border.size();
+    }
+    m_next_front.extend(total);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::place_band( unsigned t_band )
+{
+    // Fusion des trois listes triées de la bande : cases intérieures, nouveaux foyers, cases du bord
+    BandBuffers const& band = m_bands[t_band];
+    std::size_t position = band.offset;
+    std::array<std::vector<std::uint32_t> const*,3> lists = {&band.cells, &band.ignited, &band.border};
+    std::array<std::size_t,3> next = {0, 0, 0};
+    for (std::size_t end = position + band.cells.size() + band.ignited.size() + band.border.size(); position < end; )
+    {
+        std::size_t smallest = 3;
+        for (std::size_t l = 0; l < 3; ++l)
+            if (next[l] < lists[l]->size() && (smallest == 3 || (*lists[l])[next[l]] < (*lists[smallest])[next[smallest]]))
+                smallest = l;
+        m_next_front.place(position++, (*lists[smallest])[next[smallest]++]);
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::spread_band( unsigned t_band )
+{
+    BandBuffers& band = m_bands[t_band];
+    band.cells.clear();
+    band.ignited.clear();
+    band.spilled.clear();
+    band.deferred.clear();
+    band.border.clear();
+    const std::size_t first_target = std::size_t(m_band_rows[t_band  ])*m_columns;
+    const std::size_t end_target   = std::size_t(m_band_rows[t_band+1])*m_columns;
 
-        for (const auto& [offset, alpha] : directions) {
-            // Vérifier si la case voisine est dans la grille
-            bool is_valid = true;
-            if (offset == m_geometry && coord.row >= m_geometry-1) is_valid = false;      // Sud
-            if (offset == -m_geometry && coord.row <= 0) is_valid = false;                // Nord
-            if (offset == 1 && coord.column >= m_geometry-1) is_valid = false;            // Est
-            if (offset == -1 && coord.column <= 0) is_valid = false;                      // Ouest
+    // Les tirages sont générés par lots de cases du front : un bloc de quatre mots par case,
+    // un mot par direction de propagation (Sud, Nord, Est, Ouest).
+    constexpr std::size_t batch_size = 256;
+    std::array<std::array<std::uint32_t,batch_size>,4> draws;
+    const std::array<std::uint32_t*,4> words = {draws[0].data(), draws[1].data(), draws[2].data(), draws[3].data()};
+    std::array<std::uint32_t,batch_size> keys;
+    const std::uint32_t step = std::uint32_t(m_time_step);
+    std::uint32_t const* cells = m_fire_front.indices();
 
-            if (is_valid) {
-                int neighbor_index = f.first + offset;
-                if (neighbor_index >= 0 && neighbor_index < m_geometry * m_geometry) {
-                    double tirage = pseudo_random(f.first * (offset + 13427) + m_time_step, m_time_step);
-                    double green_power = m_vegetation_map[neighbor_index];
-                    double correction = power * log_factor(green_power);
-                    
-                    if (tirage < alpha * p1 * correction) {
-                        m_fire_map[neighbor_index] = 255.;
-                        next_front[neighbor_index] = 255.;
-                    }
-                }
+    for (std::size_t first = m_band_cells[t_band]; first < m_band_cells[t_band+1]; first += batch_size)
+    {
+        std::size_t count = std::min(batch_size, m_band_cells[t_band+1] - first);
+        for (std::size_t k = 0; k < count; ++k) keys[k] = global_cell(cells[first + k]);
+        m_rng.fill(keys.data(), count, step, ignition_stream, words);
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            std::size_t index = cells[first + k];
+            std::uint8_t intensity = m_fire_front.intensity(index);
+            // Coordonnées de la case en feu dans le sous-domaine :
+            LexicoIndices coord{unsigned(index/m_columns), unsigned(index%m_columns)};
+            // On teste les quatre cases voisines présentes dans le sous-domaine. Seules les propagations
+            // vers le Sud ou le Nord peuvent sortir de la bande : elles sont confiées à la bande voisine.
+            // Celles qui sortent du sous-domaine sont calculées par le voisin, à partir de sa ligne fantôme.
+            if (coord.row < m_rows-1 && ignites(index + m_columns, South, intensity, draws[South][k]))
+            {
+                if (index + m_columns < end_target) ignite(index + m_columns, band);
+                else band.spilled.push_back(std::uint32_t(index + m_columns));
+            }
+            if (coord.row > 0 && ignites(index - m_columns, North, intensity, draws[North][k]))
+            {
+                if (index - m_columns >= first_target) ignite(index - m_columns, band);
+                else band.spilled.push_back(std::uint32_t(index - m_columns));
             }
+            if (coord.column < m_columns-1 && ignites(index + 1, East, intensity, draws[East][k]))
+                ignite(index + 1, band);
+            if (coord.column > 0 && ignites(index - 1, West, intensity, draws[West][k]))
+                ignite(index - 1, band);
+        }
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::spread_halo( Side t_side, unsigned t_band, BandBuffers& t_buffers )
+{
+    // Une source fantôme n'allume que sa voisine dans le sous-domaine : Nord vers le Sud dans la
+    // ligne 0, Sud vers le Nord dans la dernière ligne, Ouest vers l'Est dans la colonne 0, Est vers
+    // l'Ouest dans la dernière colonne. Le tirage est celui que ferait le propriétaire de la source.
+    const std::uint32_t step = std::uint32_t(m_time_step);
+    if (t_side == Side::north || t_side == Side::south)
+    {
+        const bool north = t_side == Side::north;
+        const Direction direction = north ? South : North;
+        const std::ptrdiff_t halo = north ? -1 : std::ptrdiff_t(m_rows);
+        const std::size_t target_start = north ? 0 : std::size_t(m_rows-1)*m_columns;
+        std::uint8_t const* intensity = halo_row(t_side);
+        for (unsigned column = 0; column < m_columns; ++column)
+        {
+            if (intensity[column] == 0) continue;
+            std::uint32_t draw = m_rng(global_cell(halo, column), step, ignition_stream)[direction];
+            if (ignites(target_start + column, direction, intensity[column], draw))
+                ignite(target_start + column, t_buffers);
+        }
+    }
+    else
+    {
+        // Les colonnes fantômes sont parcourues sur les lignes de la bande
+        const bool west = t_side == Side::west;
+        const Direction direction = west ? East : West;
+        const std::ptrdiff_t halo = west ? -1 : std::ptrdiff_t(m_columns);
+        const unsigned target_column = west ? 0 : m_columns - 1;
+        std::uint8_t const* intensity = halo_column(t_side);
+        for (unsigned row = m_band_rows[t_band]; row < m_band_rows[t_band+1]; ++row)
+        {
+            if (intensity[row] == 0) continue;
+            std::uint32_t draw = m_rng(global_cell(row, halo), step, ignition_stream)[direction];
+            std::size_t target = std::size_t(row)*m_columns + target_column;
+            if (ignites(target, direction, intensity[row], draw))
+                ignite(target, t_buffers);
+        }
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::receive_spills( unsigned t_band )
+{
+    const std::size_t first_target = std::size_t(m_band_rows[t_band  ])*m_columns;
+    const std::size_t end_target   = std::size_t(m_band_rows[t_band+1])*m_columns;
+    if (t_band > 0)
+        for (auto target : m_bands[t_band-1].spilled)
+            if (target >= first_target) ignite(target, m_bands[t_band]);
+    if (t_band + 1 < m_band_rows.size() - 1)
+        for (auto target : m_bands[t_band+1].spilled)
+            if (target < end_target) ignite(target, m_bands[t_band]);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::burn_cell( std::size_t t_index, std::uint32_t t_extinction_draw, std::vector<std::uint32_t>& t_survivors )
+{
+    // Une case rallumée pendant la propagation repart de 255
+    std::uint8_t intensity = m_next_front.contains(t_index) ? 255u : m_fire_front.intensity(t_index);
+
+    // Mise à jour de la végétation et test d'extinction
+    if (m_vegetation_map[t_index] > 0) {
+        m_vegetation_map[t_index] -= 1;
+        if ((t_extinction_draw >> 2) < m_extinction_threshold) {
+            intensity /= 2;
+            if (intensity <= 1) intensity = 0;
         }
+    } else {
+        intensity = 0;
+    }
 
-        // Mise à jour de la végétation et test d'extinction
-        if (m_vegetation_map[f.first] > 0) {
-            m_vegetation_map[f.first] -= 1;
-            double tirage = pseudo_random(f.first * 7919 + m_time_step, m_time_step);
-            if (tirage < p2) {
-                next_front[f.first] = next_front[f.first]/2;
-                if (next_front[f.first] <= 1) {
-                    next_front.erase(f.first);
-                    m_fire_map[f.first] = 0;  // La cellule devient noire (brûlée)
-                    m_vegetation_map[f.first] = 0;  // Plus de végétation
-                }
-            }
-        } else {
-            next_front.erase(f.first);
-            m_fire_map[f.first] = 0;  // La cellule devient noire (brûlée)
-            m_vegetation_map[f.first] = 0;  // Plus de végétation
+    if (intensity > 0) {
+        m_next_front.mark(t_index, intensity);
+        t_survivors.push_back(std::uint32_t(t_index));
+    } else {
+        m_next_front.erase(t_index);
+        m_fire_map[t_index] = 0;  // La cellule devient noire (brûlée)
+        m_vegetation_map[t_index] = 0;  // Plus de végétation
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::burn_band( unsigned t_band )
+{
+    // Combustion des cases intérieures du front de la bande. Celles du bord peuvent encore être
+    // rallumées depuis les lignes ou colonnes fantômes : elles attendent burn_border().
+    BandBuffers& band = m_bands[t_band];
+    constexpr std::size_t batch_size = 256;
+    std::array<std::array<std::uint32_t,batch_size>,4> draws;
+    const std::array<std::uint32_t*,4> words = {draws[0].data(), draws[1].data(), draws[2].data(), draws[3].data()};
+    std::array<std::uint32_t,batch_size> keys;
+    const std::uint32_t step = std::uint32_t(m_time_step);
+    std::uint32_t const* cells = m_fire_front.indices();
+
+    for (std::size_t first = m_band_cells[t_band]; first < m_band_cells[t_band+1]; first += batch_size)
+    {
+        std::size_t count = std::min(batch_size, m_band_cells[t_band+1] - first);
+        for (std::size_t k = 0; k < count; ++k) keys[k] = global_cell(cells[first + k]);
+        m_rng.fill(keys.data(), count, step, extinction_stream, words);
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            std::size_t index = cells[first + k];
+            if (on_border(index)) band.deferred.push_back(std::uint32_t(index));
+            else                  burn_cell(index, draws[0][k], band.cells);
         }
     }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::burn_border( unsigned t_band )
+{
+    // Sources situées dans les lignes et colonnes fantômes : elles n'allument que les cases du bord,
+    // dont la combustion peut alors se terminer.
+    BandBuffers& band = m_bands[t_band];
+    if (t_band == 0 && has_halo(Side::north)) spread_halo(Side::north, t_band, band);
+    if (t_band + 1 == m_band_rows.size() - 1 && has_halo(Side::south)) spread_halo(Side::south, t_band, band);
+    if (has_halo(Side::west)) spread_halo(Side::west, t_band, band);
+    if (has_halo(Side::east)) spread_halo(Side::east, t_band, band);
 
-    m_fire_front.swap(next_front);
-    m_time_step += 1;
-    return !m_fire_front.empty();
+    const std::uint32_t step = std::uint32_t(m_time_step);
+    for (auto index : band.deferred)
+        burn_cell(index, m_rng(global_cell(index), step, extinction_stream)[0], band.border);
+    std::sort(band.ignited.begin(), band.ignited.end());
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::sparse_interior()
+{
+    const unsigned nb_bands = partition_front();
+
+#pragma omp parallel num_threads(nb_bands) if(nb_bands > 1)
+    {
+        // Phase 1 : propagation. Elle ne lit que l'état en début de pas (front courant et végétation),
+        // l'ordre de parcours du front et le découpage en bandes n'influent donc pas sur le résultat.
+#pragma omp for schedule(static)
+        for (unsigned band = 0; band < nb_bands; ++band)
+            spread_band(band);
+        // Phase 2 : réception des allumages des bandes voisines, puis combustion
+#pragma omp for schedule(static)
+        for (unsigned band = 0; band < nb_bands; ++band)
+        {
+            receive_spills(band);
+            burn_band(band);
+        }
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::copy_border_column( Side t_side, std::uint8_t* t_column ) const
+{
+    std::uint8_t const* intensity = m_fire_front.data() + (t_side == Side::west ? 0 : m_columns - 1);
+    for (unsigned row = 0; row < m_rows; ++row)
+        t_column[row] = intensity[std::size_t(row)*m_columns];
 }
 // ====================================================================================================================
 std::size_t   
 Model::get_index_from_lexicographic_indices( LexicoIndices t_lexico_indices  ) const
 {
-    return t_lexico_indices.row*this->geometry() + t_lexico_indices.column;
+    return std::size_t(t_lexico_indices.row - m_first_row)*m_columns + (t_lexico_indices.column - m_first_column);
 }
 // --------------------------------------------------------------------------------------------------------------------
 auto 
-Model::get_lexicographic_from_index( std::size_t t_global_index ) const -> LexicoIndices
+Model::get_lexicographic_from_index( std::size_t t_local_index ) const -> LexicoIndices
 {
     LexicoIndices ind_coords;
-    ind_coords.row    = t_global_index/this->geometry();
-    ind_coords.column = t_global_index%this->geometry();
+    ind_coords.row    = m_first_row    + t_local_index/m_columns;
+    ind_coords.column = m_first_column + t_local_index%m_columns;
     return ind_coords;
 }
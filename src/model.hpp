@@ -1,8 +1,11 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
 #include <array>
 #include <vector>
-#include <unordered_map>
+#include "fire_front.hpp"
+#include "counter_rng.hpp"
+#include "map_view.hpp"
 
 /**
  * @brief 
@@ -17,38 +20,201 @@ public:
         unsigned row, column;
     };
 
+    // Moteur de mise à jour : parcours du front de feu (sparse) ou balayage vectorisé
+    // des lignes de la grille qui entourent le front (dense).
+    enum class Engine { sparse, dense };
+
+    // Sous-domaine simulé : bloc de lignes [first_row, first_row + nb_rows) et de colonnes
+    // [first_column, first_column + nb_columns) de la grille. Les cartes et le front ne couvrent que
+    // ce bloc ; les tirages restent indexés par la case globale, un ensemble de sous-domaines donne
+    // donc exactement le résultat du domaine entier.
+    struct Domain
+    {
+        unsigned first_row, nb_rows, first_column, nb_columns;
+    };
+    // Bords d'un sous-domaine, voisins d'un autre sous-domaine
+    enum class Side { north, south, west, east };
+
+    // Les indices de case sont locaux au sous-domaine, les coordonnées lexicographiques sont globales
     std::size_t   get_index_from_lexicographic_indices( LexicoIndices t_lexico_indices  ) const;
-    LexicoIndices get_lexicographic_from_index        ( std::size_t t_global_index ) const;
-    std::unordered_map<std::size_t, std::uint8_t> m_fire_front;
+    LexicoIndices get_lexicographic_from_index        ( std::size_t t_local_index ) const;
+    Model( double t_length, unsigned t_discretization, std::array<double,2> t_wind,
+           LexicoIndices t_start_fire_position, double t_max_wind = 60., std::uint64_t t_seed = 0 );
     Model( double t_length, unsigned t_discretization, std::array<double,2> t_wind,
-           LexicoIndices t_start_fire_position, double t_max_wind = 60. );
+           LexicoIndices t_start_fire_position, Domain t_domain, double t_max_wind = 60., std::uint64_t t_seed = 0 );
+    // Déplaçable (reprise d'un point de sauvegarde, cf. checkpoint.hpp), mais pas copiable. Les vues
+    // sur les cartes (MapView) restent valides après un déplacement.
     Model( Model const & ) = delete;
-    Model( Model      && ) = delete;
+    Model( Model      && ) = default;
     ~Model() = default;
 
     Model& operator = ( Model const & ) = delete;
-    Model& operator = ( Model      && ) = delete;
+    Model& operator = ( Model      && ) = default;
 
     bool update();
+    // Nouvelle simulation sur le même terrain (longueur, grille, sous-domaine, vent maximal), sans
+    // réallocation : l'état est celui d'un Model construit avec t_wind, t_start_fire_position et t_seed
+    void reset( std::array<double,2> t_wind, LexicoIndices t_start_fire_position, std::uint64_t t_seed );
+    // update() en deux temps, pour recouvrir l'échange des fantômes par le calcul : update_interior()
+    // fait évoluer les cases qui ne dépendent pas des lignes ni des colonnes fantômes, update_border()
+    // termine le pas avec celles du bord. Les fantômes ne sont lus que par update_border(), les bords
+    // envoyés (border_row, copy_border_column) ne sont modifiés par aucune des deux.
+    void update_interior();
+    bool update_border();
+    void   set_engine( Engine t_engine ) { m_engine = t_engine; }
+    Engine engine() const { return m_engine; }
+    // Nombre de threads utilisés par update() ; le résultat est identique quel que soit ce nombre
+    void     set_threads( unsigned t_nb_threads ) { m_nb_threads = t_nb_threads > 0 ? t_nb_threads : 1; }
+    unsigned threads() const { return m_nb_threads; }
 
     unsigned geometry() const { return m_geometry; }
-    std::vector<std::uint8_t> vegetal_map() const { return m_vegetation_map; }
-    std::vector<std::uint8_t> fire_map() const { return m_fire_map; }
+    Domain   domain() const { return {m_first_row, m_rows, m_first_column, m_columns}; }
+    // Changement de sous-domaine en cours de simulation (équilibrage de charge) : l'état du nouveau bloc
+    // est fourni case par case, en trois plans de t_domain.nb_rows x t_domain.nb_columns octets
+    // (végétation, feu, intensité du front). Le pas de temps et les fantômes (remis à zéro) sont conservés.
+    void     set_domain( Domain t_domain, std::uint8_t const* t_vegetation, std::uint8_t const* t_fire,
+                         std::uint8_t const* t_intensity );
+    // Cartes du sous-domaine, lues en place (pas de ligne domain().nb_columns)
+    MapView  vegetal_map() const { return m_vegetation_map; }
+    MapView  fire_map() const { return m_fire_map; }
     std::size_t time_step() const { return m_time_step; }
+    // Reprise : l'état des cases (set_domain) et le pas de temps suffisent à continuer à l'identique,
+    // les tirages ne dépendant que de la graine, de la case et du pas
+    void        set_time_step( std::size_t t_time_step ) { m_time_step = t_time_step; }
+    std::uint64_t seed() const { return m_rng.seed(); }
+    double      length() const { return m_length; }
+    std::array<double,2> wind() const { return m_wind; }
+    double      max_wind() const { return m_max_wind; }
+    FireFront const& fire_front() const { return m_fire_front; }
+    // Seuils entiers des tirages (Q30), repris par les modèles qui doivent reproduire exactement celui-ci
+    std::array<std::array<std::uint32_t,256>,4> const& ignition_coefficients() const { return m_ignition_coef; }
+    std::array<std::uint32_t,256> const& green_coefficients() const { return m_green_coef; }
+    std::uint32_t extinction_threshold() const { return m_extinction_threshold; }
+
+    // Échange entre sous-domaines voisins, avant chaque update() : les intensités du front sur un
+    // bord sont recopiées dans la ligne ou la colonne fantôme correspondante du voisin.
+    // Bords Nord et Sud : lignes contiguës de domain().nb_columns intensités.
+    std::uint8_t const* border_row( Side t_side ) const
+    { return m_fire_front.data() + (t_side == Side::north ? 0 : std::size_t(m_rows-1)*m_columns); }
+    std::uint8_t*       halo_row  ( Side t_side )
+    { return m_fire_front.data() + (t_side == Side::north ? -std::ptrdiff_t(m_columns) : std::ptrdiff_t(m_rows)*m_columns); }
+    std::uint8_t const* halo_row  ( Side t_side ) const
+    { return m_fire_front.data() + (t_side == Side::north ? -std::ptrdiff_t(m_columns) : std::ptrdiff_t(m_rows)*m_columns); }
+    // Bords Ouest et Est : colonnes de domain().nb_rows intensités, recopiées dans t_column
+    void                copy_border_column( Side t_side, std::uint8_t* t_column ) const;
+    std::uint8_t*       halo_column( Side t_side )
+    { return t_side == Side::west ? m_halo_west.data() : m_halo_east.data(); }
+    std::uint8_t const* halo_column( Side t_side ) const
+    { return t_side == Side::west ? m_halo_west.data() : m_halo_east.data(); }
 
 private:
-    
+    // Directions de propagation (depuis la case source) et flux de tirages aléatoires
+    enum Direction : std::uint32_t { South = 0, North = 1, East = 2, West = 3 };
+    static constexpr std::uint32_t ignition_stream = 0, extinction_stream = 1;
+
+    // Le pas de temps est découpé en bandes de lignes contiguës, une par thread. Chaque bande
+    // n'écrit que dans ses propres cases ; les allumages qui débordent sur une bande voisine sont
+    // transmis à celle-ci. Le résultat ne dépend donc pas du nombre de bandes.
+    struct BandBuffers
+    {
+        std::vector<std::uint32_t> cells;     // Cases du front suivant, dans l'ordre croissant
+        std::vector<std::uint32_t> ignited;   // Cases nouvellement allumées (moteur creux)
+        std::vector<std::uint32_t> spilled;   // Allumages destinés aux bandes voisines
+        std::vector<std::uint32_t> deferred;  // Cases du front au bord, brûlées après réception des fantômes
+        std::vector<std::uint32_t> border;    // Cases du front suivant issues du bord, dans l'ordre croissant
+        std::vector<std::uint32_t> row_draws; // Moteur dense : tirages de trois lignes consécutives
+        std::size_t offset = 0;               // Position de la bande dans le front suivant
+    };
+
+    // Case globale (clé des tirages) d'une case locale, éventuellement dans une ligne ou colonne fantôme
+    std::uint32_t global_cell( std::ptrdiff_t t_row, std::ptrdiff_t t_column ) const
+    { return std::uint32_t((std::ptrdiff_t(m_first_row) + t_row)*m_geometry + std::ptrdiff_t(m_first_column) + t_column); }
+    std::uint32_t global_cell( std::size_t t_local_index ) const
+    { return global_cell(std::ptrdiff_t(t_local_index/m_columns), std::ptrdiff_t(t_local_index%m_columns)); }
+    bool has_halo( Side t_side ) const
+    {
+        switch (t_side)
+        {
+        case Side::north: return m_first_row > 0;
+        case Side::south: return m_first_row + m_rows < m_geometry;
+        case Side::west : return m_first_column > 0;
+        default         : return m_first_column + m_columns < m_geometry;
+        }
+    }
+    // Case dont l'évolution dépend d'une ligne ou d'une colonne fantôme
+    bool on_border( std::size_t t_index ) const
+    {
+        return (has_halo(Side::north) && t_index < m_columns)
+            || (has_halo(Side::south) && t_index >= std::size_t(m_rows-1)*m_columns)
+            || (has_halo(Side::west)  && t_index%m_columns == 0)
+            || (has_halo(Side::east)  && t_index%m_columns == m_columns-1);
+    }
+
+    void start_fire( LexicoIndices t_start_fire_position );
+    void touch_rows( unsigned t_first, unsigned t_end )
+    {
+        m_touched_rows[0] = std::min(m_touched_rows[0], t_first);
+        m_touched_rows[1] = std::max(m_touched_rows[1], t_end);
+    }
+    void set_wind( std::array<double,2> t_wind );  // Coefficients de propagation et seuils des tirages
+
+    unsigned partition_front();
+    void ignite( std::size_t t_target, BandBuffers& t_buffers );
+    bool ignites( std::size_t t_target, Direction t_direction, std::uint8_t t_source, std::uint32_t t_draw ) const
+    {
+        return (t_draw >> 2) < std::uint64_t(m_ignition_coef[t_direction][t_source])*m_green_coef[m_vegetation_map[t_target]];
+    }
+    void reserve_front( unsigned t_nb_bands );
+    void place_band( unsigned t_band );
+
+    void sparse_interior();
+    void spread_band( unsigned t_band );
+    void spread_halo( Side t_side, unsigned t_band, BandBuffers& t_buffers );
+    void receive_spills( unsigned t_band );
+    void burn_cell( std::size_t t_index, std::uint32_t t_extinction_draw, std::vector<std::uint32_t>& t_survivors );
+    void burn_band( unsigned t_band );
+    void burn_border( unsigned t_band );
+
+    void dense_interior();
+    void build_ignition_tables();
+    void sweep_band( unsigned t_band, unsigned t_first_row, unsigned t_end_row );
+    void sweep_border( unsigned t_band );
+    void dense_cell( std::size_t t_index, bool t_ignited, std::uint32_t t_extinction_draw, std::vector<std::uint32_t>& t_cells );
+    void dense_border_cell( std::size_t t_index, unsigned t_row, unsigned t_column, std::vector<std::uint32_t>& t_cells );
+    bool dense_ignition( std::size_t t_index, int t_row, unsigned t_column, BandBuffers const& t_buffers ) const;
+    void dense_row_draws( int t_row, BandBuffers& t_buffers );
+    // Ligne t_row (de -1 à m_rows, lignes fantômes comprises) du tampon tournant de tirages
+    std::uint32_t*       row_draws( BandBuffers& t_buffers, int t_row, Direction t_direction ) const
+    { return t_buffers.row_draws.data() + (((t_row%3 + 3)%3)*4 + t_direction)*(m_columns+2) + 1; }
+    std::uint32_t const* row_draws( BandBuffers const& t_buffers, int t_row, Direction t_direction ) const
+    { return t_buffers.row_draws.data() + (((t_row%3 + 3)%3)*4 + t_direction)*(m_columns+2) + 1; }
 
     double m_length;                    // Taille du carré représentant le terrain (en km)
     double m_distance;                  // Taille d'une case du terrain modélisé
     std::size_t m_time_step=0;          // Dernier numéro du pas de temps calculé
     unsigned m_geometry;                // Taille en nombre de cases de la carte 2D
+    unsigned m_first_row, m_rows;       // Lignes du sous-domaine simulé
+    unsigned m_first_column, m_columns; // Colonnes du sous-domaine simulé (m_columns : pas d'une ligne locale)
     std::array<double,2> m_wind{0.,0.}; // Vitesse et direction du vent suivant les axes x et y en km/h
     double m_wind_speed;                // Norme euclidienne de la vitesse du vent
     double m_max_wind; //+ Vitesse à partir de laquelle le feu ne peut pas se propager dans le sens opposé à celui du vent.
+    CounterRng m_rng;                   // Tirages indexés par (graine, case, pas de temps, flux)
     std::vector<std::uint8_t> m_vegetation_map, m_fire_map;
+    FireFront m_fire_front;             // Cases en feu, parcourues dans l'ordre mémoire
+    FireFront m_next_front;             // Front du pas suivant, réutilisé d'un pas à l'autre
+    std::vector<std::uint8_t> m_halo_west, m_halo_east; // Colonnes fantômes (les lignes fantômes sont dans le front)
+    // Lignes [premier, fin) dont l'état a pu changer depuis la construction : reset() ne remet à zéro qu'elles
+    std::array<unsigned,2> m_touched_rows{~0u, 0u};
     double p1{0.}, p2{0.};
     double alphaEastWest, alphaWestEast, alphaSouthNorth, alphaNorthSouth;
-
-   
+    Engine m_engine = Engine::sparse;
+    // Seuils entiers en Q30, indexés par direction (Sud, Nord, Est, Ouest) :
+    // seuil d'allumage = m_ignition_coef[direction][intensité de la source] * m_green_coef[végétation], sur 64 bits
+    std::array<std::array<std::uint32_t,256>,4> m_ignition_coef;
+    std::array<std::uint32_t,256> m_green_coef;
+    std::uint32_t m_extinction_threshold;
+    unsigned m_nb_threads;                  // Nombre maximal de threads pour update()
+    std::vector<BandBuffers> m_bands;       // Tampons par bande, réutilisés d'un pas à l'autre
+    std::vector<unsigned>    m_band_rows;   // Bande b : lignes [m_band_rows[b], m_band_rows[b+1])
+    std::vector<std::size_t> m_band_cells;  // Bande b : front courant [m_band_cells[b], m_band_cells[b+1])
 };
@@ -0,0 +1,375 @@
+#include <string>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <sys/resource.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "model.hpp"
+
+// Banc d'essai reproductible de Model : construction et update() sur une matrice de cas (taille de
+// grille, vent, moteur, charge), sans affichage. Deux sortes de charge :
+//  - un foyer ponctuel (au centre, dans un coin ou au milieu d'un bord), simulé depuis le pas 0 : front
+//    jeune, de quelques cases à quelques milliers ;
+//  - un front synthétique de densité donnée : une fraction des cases, tirée par Philox à partir de la
+//    graine, est en feu à pleine intensité (chargée par set_domain, hors mesure).
+// Chaque cas est répété : warmup répétitions non mesurées, puis repeat répétitions mesurées, chacune
+// sur un modèle neuf et les mêmes tirages ; on garde la médiane (et le minimum) des temps. Les nombres
+// de répétitions, de pas, de threads et la graine sont fixés par défaut et recopiés dans les résultats :
+// deux exécutions avec les mêmes options sont comparables d'un commit à l'autre (--label pour les
+// distinguer). Sorties : tableau sur la sortie standard, JSON (--json) et CSV (--csv).
+struct ParamsType {
+    std::vector<unsigned> sizes{100u, 500u, 1000u, 2000u, 4000u, 8000u};
+    std::vector<std::array<double,2>> winds{{0., 0.}, {10., 0.}, {20., 20.}};
+    std::vector<std::string> starts{"centre", "coin", "bord"};
+    std::vector<double> densities{0.0001, 0.001, 0.01}; // Fronts synthétiques (cas en plus des foyers)
+    std::vector<Model::Engine> engines{Model::Engine::sparse, Model::Engine::dense};
+    unsigned steps{10u};                  // Pas mesurés par répétition
+    unsigned warmup{1u};
+    unsigned repeat{5u};
+    unsigned threads{1u};                 // Threads de update() : 1 par défaut, pour des chiffres stables
+    std::uint64_t seed{0};
+    std::string label;                    // Libellé libre recopié dans les résultats (commit, machine...)
+    std::string json, csv;
+};
+
+struct BenchCase {
+    unsigned size;
+    std::array<double,2> wind;
+    Model::Engine engine;
+    std::string start;                    // Foyer ponctuel, vide pour un front synthétique
+    double density;                       // Fraction de cases en feu du front synthétique, 0 pour un foyer
+};
+
+struct BenchResult {
+    unsigned steps{0};                    // Pas effectivement calculés par répétition (extinction possible)
+    double construct_ms{0.};              // Médiane
+    double step_ms{0.};                   // Médiane, par pas
+    double step_ms_min{0.};
+    double mean_front{0.};                // Cases actives par pas mesuré
+    double ns_per_cell{0.};               // Temps médian par case active traitée
+    double peak_rss_mib{0.};              // Crête de mémoire résidente pendant le cas (front synthétique compris)
+};
+
+std::vector<std::string> split(std::string const& list) {
+    std::vector<std::string> items;
+    std::istringstream stream(list);
+    for (std::string item; std::getline(stream, item, ',');)
+        if (!item.empty()) items.push_back(item);
+    return items;
+}
+
+bool analyze_arg(int nargs, char* args[], ParamsType& params) {
+    try {
+        for (int i = 1; i < nargs; ++i) {
+            std::string arg = args[i];
+            auto has_values = [&](int nb_values) {
+                if (i + nb_values < nargs) return true;
+                std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
+                return false;
+            };
+            if (arg == "--sizes") {
+                if (!has_values(1)) return false;
+                params.sizes.clear();
+                for (auto const& item : split(args[++i])) params.sizes.push_back(unsigned(std::stoul(item)));
+            }
+            else if (arg == "--winds") {
+                if (!has_values(1)) return false;
+                params.winds.clear();
+                for (auto const& item : split(args[++i])) {
+                    auto colon = item.find(':');
+                    if (colon == std::string::npos) {
+                        std::cerr << "[ERREUR] Vent « vx:vy » attendu : " << item << std::endl;
+                        return false;
+                    }
+                    params.winds.push_back({std::stod(item.substr(0, colon)), std::stod(item.substr(colon + 1))});
+                }
+            }
+            else if (arg == "--starts") {
+                if (!has_values(1)) return false;
+                params.starts = split(args[++i]);
+                for (auto const& start : params.starts)
+                    if (start != "centre" && start != "coin" && start != "bord") {
+                        std::cerr << "[ERREUR] Foyer inconnu : " << start << " (centre, coin ou bord)" << std::endl;
+                        return false;
+                    }
+            }
+            else if (arg == "--densities") {
+                if (!has_values(1)) return false;
+                params.densities.clear();
+                for (auto const& item : split(args[++i])) params.densities.push_back(std::stod(item));
+            }
+            else if (arg == "--engines") {
+                if (!has_values(1)) return false;
+                params.engines.clear();
+                for (auto const& name : split(args[++i])) {
+                    if (name != "sparse" && name != "dense") {
+                        std::cerr << "[ERREUR] Moteur inconnu : " << name << " (sparse ou dense)" << std::endl;
+                        return false;
+                    }
+                    params.engines.push_back(name == "dense" ? Model::Engine::dense : Model::Engine::sparse);
+                }
+            }
+            else if (arg == "--steps") {
+                if (!has_values(1)) return false;
+                params.steps = unsigned(std::stoul(args[++i]));
+            }
+            else if (arg == "--warmup") {
+                if (!has_values(1)) return false;
+                params.warmup = unsigned(std::stoul(args[++i]));
+            }
+            else if (arg == "--repeat") {
+                if (!has_values(1)) return false;
+                params.repeat = unsigned(std::stoul(args[++i]));
+            }
+            else if (arg == "--threads") {
+                if (!has_values(1)) return false;
+                params.threads = unsigned(std::stoul(args[++i]));
+            }
+            else if (arg == "--seed") {
+                if (!has_values(1)) return false;
+                params.seed = std::stoull(args[++i]);
+            }
+            else if (arg == "--label") {
+                if (!has_values(1)) return false;
+                params.label = args[++i];
+                // Recopié tel quel dans le CSV et le JSON
+                if (params.label.find_first_of(",\"\\\n") != std::string::npos) {
+                    std::cerr << "[ERREUR] Le libellé ne doit contenir ni virgule, ni guillemet, ni barre oblique inverse."
+                              << std::endl;
+                    return false;
+                }
+            }
+            else if (arg == "--json") {
+                if (!has_values(1)) return false;
+                params.json = args[++i];
+            }
+            else if (arg == "--csv") {
+                if (!has_values(1)) return false;
+                params.csv = args[++i];
+            }
+            else {
+                if (arg != "-h" && arg != "--help")
+                    std::cerr << "[ERREUR] Option inconnue : " << arg << std::endl;
+                std::cout << "Usage : " << args[0] << " [--sizes 100,1000,...] [--winds vx:vy,...]"
+                          << " [--starts centre,coin,bord] [--densities 0.001,...] [--engines sparse,dense]"
+                          << " [--steps n] [--warmup n] [--repeat n] [--threads n] [--seed s] [--label texte]"
+                          << " [--json fichier] [--csv fichier]" << std::endl;
+                return false;
+            }
+        }
+    }
+    catch (std::exception const&) {
+        std::cerr << "[ERREUR] Valeur numérique invalide." << std::endl;
+        return false;
+    }
+    if (params.repeat == 0 || params.steps == 0 || params.threads == 0) {
+        std::cerr << "[ERREUR] Les nombres de répétitions, de pas et de threads doivent être positifs." << std::endl;
+        return false;
+    }
+    for (unsigned size : params.sizes)
+        if (size == 0) {
+            std::cerr << "[ERREUR] Les tailles de grille doivent être positives." << std::endl;
+            return false;
+        }
+    for (double density : params.densities)
+        if (density <= 0 || density > 1) {
+            std::cerr << "[ERREUR] Les densités de front doivent être dans ]0, 1]." << std::endl;
+            return false;
+        }
+    return true;
+}
+
+// Crête de mémoire résidente du processus, en octets. Sous Linux, reset_peak_rss() la ramène à la
+// mémoire résidente courante : la crête mesurée est alors celle du cas. Ailleurs, c'est la crête depuis
+// le lancement.
+void reset_peak_rss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs) clear_refs << "5" << std::flush;
+}
+
+double peak_rss_bytes() {
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line);)
+        if (line.compare(0, 6, "VmHWM:") == 0) return 1024. * std::stod(line.substr(6));
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return 1024. * double(usage.ru_maxrss);
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    const std::size_t half = values.size() / 2;
+    return values.size() % 2 ? values[half] : 0.5 * (values[half - 1] + values[half]);
+}
+
+Model::LexicoIndices start_position(std::string const& start, unsigned size) {
+    if (start == "coin") return {0u, 0u};
+    if (start == "bord") return {0u, size / 2};
+    return {size / 2, size / 2};
+}
+
+BenchResult run(BenchCase const& bench, ParamsType const& params) {
+    using clock = std::chrono::steady_clock;
+    const unsigned d = bench.size;
+    const std::size_t nb_cells = std::size_t(d) * d;
+    reset_peak_rss();
+
+    // Front synthétique : végétation intacte, cases en feu à 255 (feu et intensité), tirées sur un flux
+    // que le modèle n'utilise pas
+    std::vector<std::uint8_t> vegetation, burning;
+    if (bench.density > 0) {
+        const CounterRng rng(params.seed);
+        const double threshold = bench.density * 4294967296.;
+        vegetation.assign(nb_cells, 255u);
+        burning.resize(nb_cells);
+        for (std::size_t cell = 0; cell < nb_cells; ++cell)
+            burning[cell] = double(rng(std::uint32_t(cell), 0u, 3u)[0]) < threshold ? 255u : 0u;
+    }
+
+    BenchResult result;
+    std::vector<double> construct_ms, run_ms;
+    std::size_t active_cells = 0;
+    for (unsigned repetition = 0; repetition < params.warmup + params.repeat; ++repetition) {
+        auto begin = clock::now();
+        Model simu(1., d, bench.wind, start_position(bench.start, d), 60., params.seed);
+        const double construct = std::chrono::duration<double, std::milli>(clock::now() - begin).count();
+        simu.set_engine(bench.engine);
+        simu.set_threads(params.threads);
+        if (bench.density > 0)
+            simu.set_domain(simu.domain(), vegetation.data(), burning.data(), burning.data());
+
+        // Tailles du front lues avant chaque pas : identiques d'une répétition à l'autre (mêmes tirages)
+        std::size_t active = 0;
+        unsigned steps = 0;
+        bool running = true;
+        begin = clock::now();
+        while (running && steps < params.steps) {
+            active += simu.fire_front().size();
+            running = simu.update();
+            ++steps;
+        }
+        const double elapsed = std::chrono::duration<double, std::milli>(clock::now() - begin).count();
+        if (repetition < params.warmup) continue;
+        construct_ms.push_back(construct);
+        run_ms.push_back(elapsed / steps);
+        result.steps = steps;
+        active_cells = active;
+    }
+    result.construct_ms = median(construct_ms);
+    result.step_ms = median(run_ms);
+    result.step_ms_min = *std::min_element(run_ms.begin(), run_ms.end());
+    result.mean_front = double(active_cells) / result.steps;
+    result.ns_per_cell = active_cells > 0 ? 1e6 * result.step_ms * result.steps / double(active_cells) : 0.;
+    result.peak_rss_mib = peak_rss_bytes() / (1024. * 1024.);
+    return result;
+}
+
+char const* engine_name(Model::Engine engine) {
+    return engine == Model::Engine::dense ? "dense" : "sparse";
+}
+
+std::string workload(BenchCase const& bench) {
+    if (bench.density == 0) return "foyer:" + bench.start;
+    std::ostringstream name;
+    name << "front:" << bench.density;
+    return name.str();
+}
+
+int main(int nargs, char* args[]) {
+    ParamsType params;
+    if (!analyze_arg(nargs, args, params))
+        return EXIT_FAILURE;
+
+    // Matrice des cas, des plus petits aux plus grands
+    std::vector<BenchCase> cases;
+    for (unsigned size : params.sizes)
+        for (auto const& wind : params.winds)
+            for (auto engine : params.engines) {
+                for (auto const& start : params.starts) cases.push_back({size, wind, engine, start, 0.});
+                for (double density : params.densities) cases.push_back({size, wind, engine, "", density});
+            }
+
+    std::ofstream json, csv;
+    if (!params.json.empty()) {
+        json.open(params.json);
+        if (!json) {
+            std::cerr << "[ERREUR] Impossible de créer " << params.json << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (!params.csv.empty()) {
+        csv.open(params.csv);
+        if (!csv) {
+            std::cerr << "[ERREUR] Impossible de créer " << params.csv << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+#if defined(__AVX2__)
+    const bool avx2 = true;
+#else
+    const bool avx2 = false;
+#endif
+#if defined(_OPENMP)
+    const int max_threads = omp_get_max_threads();
+#else
+    const int max_threads = 1;
+#endif
+    std::cout << "Cas : " << cases.size() << " - pas mesurés : " << params.steps << " - répétitions : "
+              << params.warmup << " + " << params.repeat << " - threads : " << params.threads << " (" << max_threads
+              << " disponibles) - graine : " << params.seed << " - AVX2 : " << (avx2 ? "oui" : "non") << std::endl;
+    std::cout << "taille  moteur  vent          charge         constr. ms   pas ms    pas/s    front moyen"
+              << "   ns/case   RSS Mio" << std::endl;
+
+    if (csv)
+        csv << "label,size,engine,wind_x,wind_y,workload,start,density,threads,steps,warmup,repeat,construct_ms,"
+               "step_ms_median,step_ms_min,steps_per_second,mean_front,ns_per_active_cell,peak_rss_mib\n";
+    if (json)
+        json << "{\n  \"label\": \"" << params.label << "\",\n  \"compiler\": \"" << __VERSION__ << "\",\n"
+             << "  \"avx2\": " << (avx2 ? "true" : "false") << ",\n  \"threads\": " << params.threads << ",\n"
+             << "  \"steps\": " << params.steps << ",\n  \"warmup\": " << params.warmup << ",\n"
+             << "  \"repeat\": " << params.repeat << ",\n  \"seed\": " << params.seed << ",\n  \"cases\": [";
+
+    for (std::size_t i = 0; i < cases.size(); ++i) {
+        BenchCase const& bench = cases[i];
+        BenchResult const result = run(bench, params);
+        const double steps_per_second = result.step_ms > 0 ? 1000. / result.step_ms : 0.;
+        std::ostringstream wind;
+        wind << bench.wind[0] << ":" << bench.wind[1];
+
+        std::cout << std::setw(6) << bench.size << "  " << std::setw(6) << engine_name(bench.engine) << "  "
+                  << std::left << std::setw(12) << wind.str() << "  " << std::setw(13) << workload(bench) << std::right
+                  << std::fixed << std::setprecision(3) << std::setw(11) << result.construct_ms
+                  << std::setw(9) << result.step_ms << std::setprecision(1) << std::setw(9) << steps_per_second
+                  << std::setw(15) << result.mean_front << std::setprecision(2) << std::setw(10) << result.ns_per_cell
+                  << std::setprecision(1) << std::setw(10) << result.peak_rss_mib << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+
+        if (csv)
+            csv << params.label << "," << bench.size << "," << engine_name(bench.engine) << "," << bench.wind[0] << ","
+                << bench.wind[1] << "," << (bench.density > 0 ? "front" : "foyer") << "," << bench.start << ","
+                << bench.density << "," << params.threads << "," << result.steps << "," << params.warmup << ","
+                << params.repeat << "," << result.construct_ms << "," << result.step_ms << "," << result.step_ms_min
+                << "," << steps_per_second << "," << result.mean_front << "," << result.ns_per_cell << ","
+                << result.peak_rss_mib << "\n" << std::flush;
+        if (json)
+            json << (i ? "," : "") << "\n    {\"size\": " << bench.size << ", \"engine\": \"" << engine_name(bench.engine)
+                 << "\", \"wind\": [" << bench.wind[0] << ", " << bench.wind[1] << "], \"workload\": \""
+                 << (bench.density > 0 ? "front" : "foyer") << "\", \"start\": \"" << bench.start
+                 << "\", \"density\": " << bench.density << ", \"steps\": " << result.steps
+                 << ", \"construct_ms\": " << result.construct_ms << ", \"step_ms_median\": " << result.step_ms
+                 << ", \"step_ms_min\": " << result.step_ms_min << ", \"steps_per_second\": " << steps_per_second
+                 << ", \"mean_front\": " << result.mean_front << ", \"ns_per_active_cell\": " << result.ns_per_cell
+                 << ", \"peak_rss_mib\": " << result.peak_rss_mib << "}" << std::flush;
+    }
+    if (json) json << "\n  ]\n}\n";
+    return EXIT_SUCCESS;
+}
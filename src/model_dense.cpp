@@ -0,0 +1,291 @@
+#include <algorithm>
+#include <cstring>
+#include "model.hpp"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Moteur dense : au lieu de parcourir le front case par case, on balaie ligne par ligne toutes
+// les cases situées entre la première et la dernière ligne en feu (plus une ligne de chaque côté).
+// Chaque case cible lit l'intensité de ses quatre voisines au début du pas, ce qui donne des
+// accès contigus et se vectorise. Les tirages sont ceux du moteur creux (bloc Philox de la case
+// source, un mot par direction), calculés une fois par ligne : les deux moteurs donnent exactement
+// le même résultat. Les bandes de lignes sont balayées en parallèle : chaque bande n'écrit que dans
+// ses propres lignes et calcule elle-même les tirages des lignes qui la bordent.
+// Dans un sous-domaine, les cases voisines d'une ligne ou d'une colonne fantôme ne sont pas
+// balayées : elles sont traitées en scalaire par sweep_border(), une fois les fantômes reçus.
+
+namespace
+{
+#if defined(__AVX2__)
+    inline __m256i load8( std::uint8_t const* t_ptr )
+    {
+        return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(t_ptr)));
+    }
+
+    // Masque des cases allumées par les sources d'une direction (8 cases consécutives). Le seuil peut
+    // dépasser 2^31 par grand vent : produits et comparaisons sur 64 bits, voies paires puis impaires.
+    inline __m256i ignition_mask( std::uint32_t const* t_coef, __m256i t_source, __m256i t_green,
+                                  std::uint32_t const* t_draws )
+    {
+        __m256i coef  = _mm256_i32gather_epi32(reinterpret_cast<int const*>(t_coef), t_source, 4);
+        __m256i draws = _mm256_srli_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(t_draws)), 2);
+        __m256i even  = _mm256_cmpgt_epi64(_mm256_mul_epu32(coef, t_green),
+                                           _mm256_and_si256(draws, _mm256_set1_epi64x(0xFFFFFFFF)));
+        __m256i odd   = _mm256_cmpgt_epi64(_mm256_mul_epu32(_mm256_srli_epi64(coef, 32), _mm256_srli_epi64(t_green, 32)),
+                                           _mm256_srli_epi64(draws, 32));
+        return _mm256_blend_epi32(even, odd, 0xAA);
+    }
+#endif
+}
+// ====================================================================================================================
+void
+Model::dense_row_draws( int t_row, BandBuffers& t_buffers )
+{
+    // Seuls les groupes de huit cases contenant une source en feu ont besoin de leurs tirages :
+    // ailleurs le seuil d'allumage est nul et la valeur du tirage est indifférente.
+    // Les lignes -1 et m_rows sont les lignes fantômes : nulles hors d'un sous-domaine, elles ne sont
+    // lues que lorsque la ligne voisine n'est pas une ligne du bord.
+    const unsigned width = m_columns;
+    const std::uint32_t step = std::uint32_t(m_time_step);
+    std::uint8_t const* intensity = m_fire_front.data() + std::ptrdiff_t(t_row)*width;
+    const std::array<std::uint32_t*,4> words = {row_draws(t_buffers, t_row, South), row_draws(t_buffers, t_row, North),
+                                                row_draws(t_buffers, t_row, East),  row_draws(t_buffers, t_row, West)};
+    for (unsigned column = 0; column < width; column += 8)
+    {
+        unsigned count = std::min(8u, width - column);
+        std::uint64_t group = 0;
+        std::memcpy(&group, intensity + column, count);
+        if (group == 0) continue;
+        m_rng.fill(global_cell(t_row, column), count, step, ignition_stream,
+                   {words[0] + column, words[1] + column, words[2] + column, words[3] + column});
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+bool
+Model::dense_ignition( std::size_t t_index, int t_row, unsigned t_column, BandBuffers const& t_buffers ) const
+{
+    std::uint8_t const* intensity = m_fire_front.data();
+    std::uint32_t green = m_green_coef[m_vegetation_map[t_index]];
+    // Hors d'un sous-domaine, les lignes fantômes du front et les colonnes fantômes sont nulles
+    std::uint8_t from_north = intensity[t_index - m_columns];
+    std::uint8_t from_south = intensity[t_index + m_columns];
+    std::uint8_t from_west  = t_column > 0           ? intensity[t_index - 1] : m_halo_west[t_row];
+    std::uint8_t from_east  = t_column < m_columns-1 ? intensity[t_index + 1] : m_halo_east[t_row];
+    return (from_north && (row_draws(t_buffers, t_row-1, South)[t_column  ] >> 2) < std::uint64_t(m_ignition_coef[South][from_north])*green)
+        || (from_south && (row_draws(t_buffers, t_row+1, North)[t_column  ] >> 2) < std::uint64_t(m_ignition_coef[North][from_south])*green)
+        || (from_west  && (row_draws(t_buffers, t_row,   East )[int(t_column)-1] >> 2) < std::uint64_t(m_ignition_coef[East ][from_west ])*green)
+        || (from_east  && (row_draws(t_buffers, t_row,   West )[t_column+1] >> 2) < std::uint64_t(m_ignition_coef[West ][from_east ])*green);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::dense_cell( std::size_t t_index, bool t_ignited, std::uint32_t t_extinction_draw, std::vector<std::uint32_t>& t_cells )
+{
+    std::uint8_t intensity = m_fire_front.intensity(t_index);
+    if (intensity > 0)
+    {
+        // Même règle de combustion que le moteur creux
+        if (t_ignited) intensity = 255u;
+        if (m_vegetation_map[t_index] > 0)
+        {
+            m_vegetation_map[t_index] -= 1;
+            if ((t_extinction_draw >> 2) < m_extinction_threshold)
+            {
+                intensity /= 2;
+                if (intensity <= 1) intensity = 0;
+            }
+        }
+        else
+            intensity = 0;
+
+        if (intensity > 0)
+        {
+            m_next_front.mark(t_index, intensity);
+            t_cells.push_back(std::uint32_t(t_index));
+        }
+        else
+        {
+            m_fire_map[t_index] = 0;
+            m_vegetation_map[t_index] = 0;
+        }
+    }
+    else if (t_ignited)
+    {
+        m_fire_map[t_index] = 255u;
+        m_next_front.mark(t_index, 255u);
+        t_cells.push_back(std::uint32_t(t_index));
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::sweep_band( unsigned t_band, unsigned t_first_row, unsigned t_end_row )
+{
+    BandBuffers& band = m_bands[t_band];
+    band.cells.clear();
+    band.ignited.clear();
+    band.border.clear();
+    if (t_first_row >= t_end_row) return;
+    band.row_draws.resize(12*(std::size_t(m_columns) + 2));
+
+    const unsigned width = m_columns;
+    const std::uint32_t step = std::uint32_t(m_time_step);
+    std::uint8_t const* intensity = m_fire_front.data();
+    // Les colonnes voisines d'une colonne fantôme sont laissées à sweep_border()
+    const bool west_column = !has_halo(Side::west);
+    const unsigned end_column = has_halo(Side::east) ? width - 1 : width;
+
+    // Tampon tournant de trois lignes de tirages : lignes row-1, row et row+1
+    dense_row_draws(int(t_first_row) - 1, band);
+    dense_row_draws(int(t_first_row), band);
+    for (unsigned row = t_first_row; row < t_end_row; ++row)
+    {
+        dense_row_draws(int(row) + 1, band);
+        std::size_t row_start = std::size_t(row)*width;
+        // Version scalaire : première et dernière colonnes, fin de ligne
+        auto sweep_cell = [&]( unsigned t_column )
+        {
+            std::size_t index = row_start + t_column;
+            std::uint8_t west = t_column > 0       ? intensity[index - 1] : m_halo_west[row];
+            std::uint8_t east = t_column < width-1 ? intensity[index + 1] : m_halo_east[row];
+            if ((intensity[index] | intensity[index - width] | intensity[index + width] | west | east) == 0) return;
+            std::uint32_t extinction = intensity[index] ? m_rng(global_cell(index), step, extinction_stream)[0] : 0u;
+            dense_cell(index, dense_ignition(index, int(row), t_column, band), extinction, band.cells);
+        };
+        if (west_column && end_column > 0) sweep_cell(0);
+        unsigned column = 1;
+#if defined(__AVX2__)
+        std::uint32_t const* from_north = row_draws(band, int(row) - 1, South);
+        std::uint32_t const* from_south = row_draws(band, int(row) + 1, North);
+        std::uint32_t const* from_west  = row_draws(band, int(row),     East ) - 1;
+        std::uint32_t const* from_east  = row_draws(band, int(row),     West ) + 1;
+        const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        for (; column + 32 <= width - 1; column += 32)
+        {
+            // Saut rapide des blocs de 32 cases sans feu ni voisin en feu
+            std::uint8_t const* p = intensity + row_start + column;
+            __m256i any = _mm256_or_si256(
+                _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p - width)),
+                                _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + width))),
+                _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p - 1)),
+                                _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + 1))));
+            any = _mm256_or_si256(any, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)));
+            if (_mm256_testz_si256(any, any)) continue;
+
+            for (unsigned block = column; block < column + 32; block += 8)
+            {
+                std::size_t index = row_start + block;
+                std::uint8_t const* q = intensity + index;
+                __m256i own   = load8(q);
+                __m256i north = load8(q - width);
+                __m256i south = load8(q + width);
+                __m256i west  = load8(q - 1);
+                __m256i east  = load8(q + 1);
+
+                __m256i green = _mm256_i32gather_epi32(reinterpret_cast<int const*>(m_green_coef.data()),
+                                                       load8(m_vegetation_map.data() + index), 4);
+                __m256i ignited = _mm256_or_si256(
+                    _mm256_or_si256(ignition_mask(m_ignition_coef[South].data(), north, green, from_north + block),
+                                    ignition_mask(m_ignition_coef[North].data(), south, green, from_south + block)),
+                    _mm256_or_si256(ignition_mask(m_ignition_coef[East ].data(), west,  green, from_west  + block),
+                                    ignition_mask(m_ignition_coef[West ].data(), east,  green, from_east  + block)));
+
+                unsigned ignited_bits = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(ignited)));
+                unsigned burning_bits = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(
+                                            _mm256_cmpgt_epi32(own, _mm256_setzero_si256()))));
+                if ((ignited_bits | burning_bits) == 0) continue;
+
+                alignas(32) std::uint32_t extinction[8];
+                if (burning_bits)
+                {
+                    __m256i block_draws[4];
+                    m_rng.generate(_mm256_add_epi32(_mm256_set1_epi32(int(global_cell(index))), lanes), step,
+                                   extinction_stream, block_draws);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(extinction), block_draws[0]);
+                }
+                // Fin de mise à jour scalaire, uniquement sur les cases qui brûlent ou s'allument
+                for (unsigned active = ignited_bits | burning_bits; active != 0; active &= active - 1)
+                {
+                    unsigned lane = unsigned(__builtin_ctz(active));
+                    dense_cell(index + lane, (ignited_bits >> lane) & 1u, extinction[lane], band.cells);
+                }
+            }
+        }
+#endif
+        for (; column < end_column; ++column)
+            sweep_cell(column);
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::dense_border_cell( std::size_t t_index, unsigned t_row, unsigned t_column, std::vector<std::uint32_t>& t_cells )
+{
+    // Case voisine d'une ligne ou d'une colonne fantôme : les tirages des sources en feu sont
+    // calculés un à un, fantômes compris, avec les mêmes clés que dense_row_draws().
+    std::uint8_t const* intensity = m_fire_front.data();
+    std::uint8_t own        = intensity[t_index];
+    std::uint8_t from_north = intensity[t_index - m_columns];
+    std::uint8_t from_south = intensity[t_index + m_columns];
+    std::uint8_t from_west  = t_column > 0           ? intensity[t_index - 1] : m_halo_west[t_row];
+    std::uint8_t from_east  = t_column < m_columns-1 ? intensity[t_index + 1] : m_halo_east[t_row];
+    if ((own | from_north | from_south | from_west | from_east) == 0) return;
+
+    const std::uint32_t step = std::uint32_t(m_time_step);
+    const std::uint32_t green = m_green_coef[m_vegetation_map[t_index]];
+    const int row = int(t_row), column = int(t_column);
+    auto lights = [&]( std::uint8_t t_source, int t_source_row, int t_source_column, Direction t_direction )
+    {
+        return t_source &&
+               (m_rng(global_cell(t_source_row, t_source_column), step, ignition_stream)[t_direction] >> 2)
+                   < std::uint64_t(m_ignition_coef[t_direction][t_source])*green;
+    };
+    bool ignited = lights(from_north, row-1, column, South) || lights(from_south, row+1, column, North)
+                || lights(from_west,  row, column-1, East)  || lights(from_east,  row, column+1, West);
+    std::uint32_t extinction = own ? m_rng(global_cell(t_index), step, extinction_stream)[0] : 0u;
+    dense_cell(t_index, ignited, extinction, t_cells);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::sweep_border( unsigned t_band )
+{
+    // Lignes du bord entières, colonnes du bord sur les autres lignes : parcours dans l'ordre mémoire
+    BandBuffers& band = m_bands[t_band];
+    band.border.clear();
+    const bool north = has_halo(Side::north), south = has_halo(Side::south);
+    const bool west  = has_halo(Side::west),  east  = has_halo(Side::east);
+    if (!(north || south || west || east)) return;
+    for (unsigned row = m_band_rows[t_band]; row < m_band_rows[t_band+1]; ++row)
+    {
+        std::size_t row_start = std::size_t(row)*m_columns;
+        if ((north && row == 0) || (south && row == m_rows-1))
+        {
+            for (unsigned column = 0; column < m_columns; ++column)
+                dense_border_cell(row_start + column, row, column, band.border);
+            continue;
+        }
+        if (west) dense_border_cell(row_start, row, 0, band.border);
+        if (east && (m_columns > 1 || !west))
+            dense_border_cell(row_start + m_columns - 1, row, m_columns - 1, band.border);
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Model::dense_interior()
+{
+    const unsigned nb_bands = partition_front();
+    // Lignes balayées : celles du front, plus une ligne de chaque côté, hormis les lignes du bord
+    // voisines d'une ligne fantôme. Le balayage ne lit donc jamais les lignes ni les colonnes fantômes.
+    unsigned first_row = m_rows, end_row = 0;
+    if (!m_fire_front.empty())
+    {
+        first_row = unsigned(m_fire_front[0].index/m_columns);
+        end_row   = unsigned(m_fire_front[m_fire_front.size()-1].index/m_columns) + 2;
+        first_row = first_row > 0 ? first_row - 1 : 0;
+        end_row   = std::min(end_row, m_rows);
+    }
+    if (has_halo(Side::north)) first_row = std::max(first_row, 1u);
+    if (has_halo(Side::south)) end_row   = std::min(end_row, m_rows - 1);
+
+#pragma omp parallel for num_threads(nb_bands) schedule(static) if(nb_bands > 1)
+    for (unsigned band = 0; band < nb_bands; ++band)
+        sweep_band(band, std::max(first_row, m_band_rows[band]), std::min(end_row, m_band_rows[band+1]));
+}
@@ -0,0 +1,41 @@
+#include <stdexcept>
+#include "model_pool.hpp"
+
+ModelPool::ModelPool( double t_length, unsigned t_discretization, std::size_t t_size, double t_max_wind )
+{
+    if (t_size == 0)
+    {
+        throw std::range_error("La réserve doit contenir au moins un modèle.");
+    }
+    for (std::size_t i = 0; i < t_size; ++i)
+    {
+        m_models.push_back(std::make_unique<Model>(t_length, t_discretization, std::array<double,2>{0., 0.},
+                                                   Model::LexicoIndices{0u, 0u}, t_max_wind));
+        m_free.push_back(m_models.back().get());
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+ModelPool::Lease
+ModelPool::acquire( std::array<double,2> t_wind, Model::LexicoIndices t_start_fire_position, std::uint64_t t_seed )
+{
+    Model* model;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_released.wait(lock, [this] { return !m_free.empty(); });
+        model = m_free.back();
+        m_free.pop_back();
+    }
+    // Remise à zéro hors du verrou : elle parcourt toute la grille
+    model->reset(t_wind, t_start_fire_position, t_seed);
+    return Lease(*this, *model);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+ModelPool::release( Model& t_model )
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_free.push_back(&t_model);
+    }
+    m_released.notify_one();
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "model.hpp"
+
+/**
+ * @brief Réserve de modèles préalloués sur un même terrain, pour enchaîner des simulations courtes
+ * (balayages de paramètres, ensembles) sans allouer ni toucher de nouvelles pages à chaque simulation.
+ *
+ * acquire() prête un modèle libre, remis à l'état initial du scénario demandé (Model::reset), et attend
+ * si tous sont prêtés ; le modèle revient à la réserve à la destruction du prêt. Utilisable depuis
+ * plusieurs threads : une réserve d'autant de modèles que de threads n'attend jamais.
+ */
+class ModelPool
+{
+public:
+    ModelPool( double t_length, unsigned t_discretization, std::size_t t_size, double t_max_wind = 60. );
+    ModelPool( ModelPool const & ) = delete;
+    ModelPool& operator = ( ModelPool const & ) = delete;
+
+    class Lease
+    {
+    public:
+        Lease( ModelPool& t_pool, Model& t_model ) : m_pool(&t_pool), m_model(&t_model) {}
+        Lease( Lease const & ) = delete;
+        Lease( Lease&& t_other ) : m_pool(t_other.m_pool), m_model(t_other.m_model) { t_other.m_model = nullptr; }
+        ~Lease() { if (m_model) m_pool->release(*m_model); }
+
+        Lease& operator = ( Lease const & ) = delete;
+
+        Model& operator *  () const { return *m_model; }
+        Model* operator -> () const { return m_model; }
+
+    private:
+        ModelPool* m_pool;
+        Model*     m_model;
+    };
+
+    Lease acquire( std::array<double,2> t_wind, Model::LexicoIndices t_start_fire_position, std::uint64_t t_seed );
+
+    std::size_t size() const { return m_models.size(); }
+    unsigned    geometry() const { return m_models.front()->geometry(); }
+
+private:
+    void release( Model& t_model );
+
+    std::vector<std::unique_ptr<Model>> m_models;
+    std::vector<Model*> m_free;
+    std::mutex m_mutex;
+    std::condition_variable m_released;
+};
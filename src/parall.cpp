@@ -1,59 +1,69 @@
 #include <string>
 #include <vector>
 #include <chrono>
-#include <omp.h>
 #include "model.hpp"
 #include <iostream>
 
 struct ParamsType {
-    double length{10.};
-    unsigned discretization{300u};
-    std::array<double,2> wind{0.,0.};
-    Model::LexicoIndices start{10u,10u};
+    double length{1.};
+    unsigned discretization{1000u};
+    std::array<double,2> wind{1.,0.};
+    Model::LexicoIndices start{500u,200u};
 };
 
-void run_simulation(int num_threads) {
+struct RunResult {
+    double update_ms;
+    std::size_t iterations;
+    std::vector<std::uint8_t> vegetal_map, fire_map;
+};
+
+// Simulation complète avec un nombre de threads fixé. Le modèle est déterministe : les cartes
+// obtenues doivent être identiques quels que soient le moteur et le nombre de threads.
+RunResult run_simulation(Model::Engine engine, unsigned num_threads, std::array<double,2> wind) {
     ParamsType params;
-    auto simu = Model(params.length, params.discretization, 
-                     params.wind, params.start);
-    const int MAX_ITERATIONS = 300;
-    int iteration = 0;
-    auto start_time = std::chrono::high_resolution_clock::now();
-    
-    omp_set_num_threads(num_threads);
-    
-    while(simu.update() && iteration < MAX_ITERATIONS) {
-        std::vector<Model::LexicoIndices> front_indices;
-        
-        #pragma omp parallel
-        {
-            std::vector<Model::LexicoIndices> private_indices;
-            #pragma omp for
-            for (size_t i = 0; i < simu.m_fire_front.size(); i++) {
-                auto it = simu.m_fire_front.begin();
-                std::advance(it, i);
-                private_indices.push_back(
-                    simu.get_lexicographic_from_index(it->first));
-            }
-            #pragma omp critical
-            front_indices.insert(front_indices.end(), 
-                               private_indices.begin(), 
-                               private_indices.end());
-        }
+    Model simu(params.length, params.discretization, wind, params.start, 10.);
+    simu.set_engine(engine);
+    simu.set_threads(num_threads);
+    const std::size_t MAX_ITERATIONS = 300;
+    std::size_t iteration = 0;
+    auto update_time = std::chrono::high_resolution_clock::duration::zero();
+
+    bool running = true;
+    while (running && iteration < MAX_ITERATIONS) {
+        auto step_start = std::chrono::high_resolution_clock::now();
+        running = simu.update();
+        update_time += std::chrono::high_resolution_clock::now() - step_start;
         iteration++;
     }
-    
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>
-                   (end_time - start_time);
-    std::cout << "Execution time with " << num_threads 
-              << " threads: " << duration.count() << " ms" << std::endl;
+    return {std::chrono::duration<double, std::milli>(update_time).count(), iteration,
+            simu.vegetal_map().copy(), simu.fire_map().copy()};
 }
 
 int main() {
-    std::vector<int> thread_counts = {1, 2, 4, 8};
-    for (int threads : thread_counts) {
-        run_simulation(threads);
+    ParamsType params;
+    std::vector<unsigned> thread_counts = {1, 2, 4, 8};
+    // Vent fort (bien au-delà du vent maximal) : probabilités d'allumage saturées à 1
+    std::vector<std::array<double,2>> winds = {params.wind, {80., 0.}};
+    bool deterministic = true;
+    for (auto const& wind : winds) {
+        std::cout << "Vent (" << wind[0] << ", " << wind[1] << ")" << std::endl;
+        RunResult reference;
+        for (auto engine : {Model::Engine::sparse, Model::Engine::dense}) {
+            char const* name = engine == Model::Engine::sparse ? "sparse" : "dense";
+            for (unsigned threads : thread_counts) {
+                RunResult result = run_simulation(engine, threads, wind);
+                // Référence : moteur creux sur un thread
+                if (engine == Model::Engine::sparse && threads == thread_counts.front()) reference = result;
+                bool identical = result.iterations == reference.iterations
+                              && result.vegetal_map == reference.vegetal_map
+                              && result.fire_map == reference.fire_map;
+                deterministic = deterministic && identical;
+                std::cout << "[" << name << "] " << threads << " threads : "
+                          << result.update_ms << " ms pour " << result.iterations << " pas"
+                          << " - accélération : " << reference.update_ms / result.update_ms
+                          << " - cartes " << (identical ? "identiques" : "DIFFÉRENTES") << std::endl;
+            }
+        }
     }
-    return 0;
-}
\ No newline at end of file
+    return deterministic ? 0 : 1;
+}
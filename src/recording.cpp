@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "recording.hpp"
+
+namespace
+{
+    // En-tête de chaque trame : {pas, taille, réservé}
+    struct FrameRecord
+    {
+        std::uint64_t step;
+        std::uint32_t size;
+        std::uint32_t reserved;
+    };
+}
+
+RecordingSink::RecordingSink( std::string const& t_path, unsigned t_width, unsigned t_height, double t_length,
+                              std::array<double,2> t_wind, std::uint64_t t_seed, unsigned t_keyframe_interval )
+    :   m_path(t_path),
+        m_encoder(std::size_t(t_width)*t_height, t_keyframe_interval)
+{
+    m_file.open(t_path, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+        throw std::runtime_error("Impossible de créer l'enregistrement " + t_path);
+
+    std::memcpy(m_header.magic, RecordingHeader::magic_string, sizeof(m_header.magic));
+    m_header.width = t_width;
+    m_header.height = t_height;
+    m_header.keyframe_interval = t_keyframe_interval;
+    m_header.length = t_length;
+    m_header.wind[0] = t_wind[0];
+    m_header.wind[1] = t_wind[1];
+    m_header.seed = t_seed;
+    m_file.write(reinterpret_cast<char const*>(&m_header), sizeof(m_header));
+    if (!m_file)
+        throw std::runtime_error("Écriture impossible de l'enregistrement " + t_path);
+    m_offset = sizeof(m_header);
+    m_writer = std::thread(&RecordingSink::write_pending, this);
+}
+// --------------------------------------------------------------------------------------------------------------------
+RecordingSink::~RecordingSink()
+{
+    try
+    {
+        close();
+    }
+    catch (std::exception const& error)
+    {
+        std::cerr << "[ERREUR] " << error.what() << std::endl;
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+RecordingSink::write( std::uint64_t t_step, MapView t_vegetation, MapView t_fire, bool )
+{
+    if (!m_file.is_open()) return;
+    const bool keyframe = m_header.keyframe_interval == 0 ? m_index.empty()
+                                                          : m_index.size() % m_header.keyframe_interval == 0;
+    std::vector<std::uint8_t> frame;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this] { return m_pending_bytes < max_pending_bytes; });
+        // Après un échec d'écriture, le fichier est perdu : inutile de coder les trames suivantes
+        if (m_failed) return;
+        if (!m_free.empty())
+        {
+            frame = std::move(m_free.back());
+            m_free.pop_back();
+        }
+    }
+    m_encoder.encode(t_vegetation, t_fire, frame);
+    const std::size_t size = frame.size();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending_bytes += size;
+        m_pending.push_back({t_step, std::move(frame)});
+    }
+    m_changed.notify_all();
+    m_index.push_back({t_step, m_offset + sizeof(FrameRecord), std::uint32_t(size), keyframe ? 1u : 0u});
+    m_offset += sizeof(FrameRecord) + size;
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+RecordingSink::write_pending()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_changed.wait(lock, [this] { return !m_pending.empty() || m_closing; });
+        if (m_pending.empty()) return;
+        PendingFrame pending = std::move(m_pending.front());
+        m_pending.pop_front();
+        lock.unlock();
+
+        // Après un échec, les trames en attente sont seulement libérées ; close() signale l'erreur
+        bool failed = false;
+        if (m_file)
+        {
+            FrameRecord record{pending.step, std::uint32_t(pending.data.size()), 0u};
+            m_file.write(reinterpret_cast<char const*>(&record), sizeof(record));
+            m_file.write(reinterpret_cast<char const*>(pending.data.data()), std::streamsize(pending.data.size()));
+            failed = !m_file;
+        }
+
+        lock.lock();
+        if (failed) m_failed = true;
+        m_pending_bytes -= pending.data.size();
+        m_free.push_back(std::move(pending.data));
+        m_changed.notify_all();
+    }
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+RecordingSink::close()
+{
+    if (!m_file.is_open()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closing = true;
+    }
+    m_changed.notify_all();
+    m_writer.join();
+    if (m_failed)
+    {
+        m_file.close();
+        throw std::runtime_error("Écriture impossible de l'enregistrement " + m_path);
+    }
+    m_file.write(reinterpret_cast<char const*>(m_index.data()), std::streamsize(m_index.size()*sizeof(RecordingIndexEntry)));
+    m_header.nb_frames = m_index.size();
+    m_header.index_offset = m_offset;
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<char const*>(&m_header), sizeof(m_header));
+    m_file.close();
+    if (!m_file)
+        throw std::runtime_error("Écriture impossible de l'index de l'enregistrement " + m_path);
+}
+// ====================================================================================================================
+Recording::Recording( std::string const& t_path )
+    :   m_decoder(0),
+        m_frame(0)
+{
+    int fd = ::open(t_path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Impossible d'ouvrir l'enregistrement " + t_path);
+    struct stat status;
+    if (::fstat(fd, &status) == 0 && std::size_t(status.st_size) >= sizeof(RecordingHeader))
+    {
+        m_size = std::size_t(status.st_size);
+        void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+            m_data = static_cast<std::uint8_t const*>(data);
+    }
+    ::close(fd);
+    if (m_data == nullptr)
+        throw std::runtime_error("Enregistrement illisible : " + t_path);
+
+    std::memcpy(&m_header, m_data, sizeof(m_header));
+    const std::uint64_t index_end = m_header.index_offset + m_header.nb_frames*sizeof(RecordingIndexEntry);
+    if (std::memcmp(m_header.magic, RecordingHeader::magic_string, sizeof(m_header.magic)) != 0 || m_header.version != 1)
+    {
+        ::munmap(const_cast<std::uint8_t*>(m_data), m_size);
+        throw std::runtime_error("Format d'enregistrement inconnu : " + t_path);
+    }
+    if (m_header.index_offset != 0 && index_end <= m_size)
+    {
+        m_index.resize(m_header.nb_frames);
+        std::memcpy(m_index.data(), m_data + m_header.index_offset, m_header.nb_frames*sizeof(RecordingIndexEntry));
+    }
+    else
+        rebuild_index();
+    m_decoder = FrameDecoder(std::size_t(m_header.width)*m_header.height);
+    m_frame = m_index.size();
+    // Lecture globalement séquentielle : le noyau peut lire en avance
+    ::madvise(const_cast<std::uint8_t*>(m_data), m_size, MADV_SEQUENTIAL);
+}
+// --------------------------------------------------------------------------------------------------------------------
+Recording::~Recording()
+{
+    ::munmap(const_cast<std::uint8_t*>(m_data), m_size);
+}
+// --------------------------------------------------------------------------------------------------------------------
+void
+Recording::rebuild_index()
+{
+    // Enregistrement interrompu : trames complètes jusqu'à la fin du fichier, une trame clé toutes les
+    // keyframe_interval trames comme à l'écriture
+    std::size_t offset = sizeof(RecordingHeader);
+    while (offset + sizeof(FrameRecord) <= m_size)
+    {
+        FrameRecord record;
+        std::memcpy(&record, m_data + offset, sizeof(record));
+        offset += sizeof(record);
+        if (record.size > m_size - offset) break;
+        const std::size_t number = m_index.size();
+        const bool keyframe = m_header.keyframe_interval == 0 ? number == 0 : number % m_header.keyframe_interval == 0;
+        m_index.push_back({record.step, offset, record.size, keyframe ? 1u : 0u});
+        offset += record.size;
+    }
+    m_header.nb_frames = m_index.size();
+}
+// --------------------------------------------------------------------------------------------------------------------
+std::size_t
+Recording::find( std::uint64_t t_step ) const
+{
+    auto entry = std::lower_bound(m_index.begin(), m_index.end(), t_step,
+                                  []( RecordingIndexEntry const& t_entry, std::uint64_t t_value ) { return t_entry.step < t_value; });
+    return std::size_t(entry - m_index.begin());
+}
+// --------------------------------------------------------------------------------------------------------------------
+bool
+Recording::seek( std::size_t t_frame )
+{
+    if (t_frame >= m_index.size()) return false;
+    // Dernière trame clé au plus à t_frame : on en repart si la trame courante ne la suit pas déjà
+    std::size_t first = t_frame;
+    while (first > 0 && m_index[first].keyframe == 0) --first;
+    if (m_frame < m_index.size() && m_frame >= first && m_frame <= t_frame)
+        first = m_frame + 1;
+    for (std::size_t frame = first; frame <= t_frame; ++frame)
+    {
+        RecordingIndexEntry const& entry = m_index[frame];
+        if (entry.offset + entry.size > m_size || !m_decoder.apply(m_data + entry.offset, entry.size))
+            return false;
+        m_frame = frame;
+    }
+    return true;
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "frame.hpp"
+#include "frame_sink.hpp"
+
+/**
+ * @brief Enregistrement d'une simulation dans un fichier binaire, relu par projection en mémoire.
+ *
+ * Format (entiers et réels dans l'ordre des octets de la machine) :
+ *  - en-tête RecordingHeader : géométrie, vent, graine, nombre de trames, position de l'index ;
+ *  - les trames, chacune précédée de {pas (64 bits), taille (32 bits), réservé (32 bits)} : trames
+ *    de FrameEncoder, une trame clé (cartes entières) toutes les keyframe_interval trames, des trames
+ *    delta (plages modifiées) entre les deux ;
+ *  - l'index : une entrée RecordingIndexEntry par trame, pour aller directement à n'importe quel pas.
+ * L'index et le nombre de trames ne sont écrits qu'à la fermeture. Un enregistrement interrompu
+ * (index_offset nul) reste lisible : l'index est alors reconstruit en parcourant les trames.
+ *
+ * Une trame par message reçu du calcul : les pas dont la trame a été sautée à l'envoi (FrameSender)
+ * manquent, leurs changements sont portés par la trame suivante.
+ */
+struct RecordingHeader
+{
+    static constexpr char magic_string[9] = "FIREREC1";
+
+    char magic[8];
+    std::uint32_t version = 1;
+    std::uint32_t width = 0, height = 0;
+    std::uint32_t keyframe_interval = 0;
+    double length = 0.;
+    double wind[2] = {0., 0.};
+    std::uint64_t seed = 0;
+    std::uint64_t nb_frames = 0;
+    std::uint64_t index_offset = 0;
+};
+
+struct RecordingIndexEntry
+{
+    std::uint64_t step;
+    std::uint64_t offset;      // Position de la trame (après son en-tête) dans le fichier
+    std::uint32_t size;
+    std::uint32_t keyframe;    // 1 pour une trame clé
+};
+
+/**
+ * @brief Destination qui enregistre chaque trame reçue.
+ *
+ * write() ne fait que coder la trame (FrameEncoder : comparaison des cartes à celles de la trame
+ * précédente) dans un tampon recyclé, puis la confie à un thread d'écriture : le calcul n'attend le
+ * disque que si plus de max_pending_bytes octets sont en attente. L'index est gardé en mémoire
+ * (24 octets par trame) jusqu'à close(). Après une erreur d'écriture (disque plein, ...), les trames
+ * suivantes sont ignorées et close() lève std::runtime_error.
+ */
+class RecordingSink : public FrameSink
+{
+public:
+    RecordingSink( std::string const& t_path, unsigned t_width, unsigned t_height, double t_length,
+                   std::array<double,2> t_wind, std::uint64_t t_seed, unsigned t_keyframe_interval = 64 );
+    RecordingSink( RecordingSink const & ) = delete;
+    ~RecordingSink();
+
+    RecordingSink& operator = ( RecordingSink const & ) = delete;
+
+    void write( std::uint64_t t_step, MapView t_vegetation, MapView t_fire, bool t_last ) override;
+    std::size_t written() const override { return m_index.size(); }
+    // Écrit l'index et complète l'en-tête ; lève std::runtime_error si une écriture a échoué.
+    // Appelée par le destructeur, qui ne fait alors que signaler l'erreur.
+    void close();
+
+    std::uint64_t bytes() const { return m_offset; }  // Taille du fichier (hors index)
+
+    static constexpr std::size_t max_pending_bytes = 64u << 20;
+
+private:
+    void write_pending();  // Boucle du thread d'écriture
+
+    std::string m_path;
+    std::ofstream m_file;
+    RecordingHeader m_header;
+    FrameEncoder m_encoder;
+    std::vector<RecordingIndexEntry> m_index;
+    std::uint64_t m_offset = 0;
+    // Trames codées en attente d'écriture et tampons déjà écrits, réutilisés (protégés par m_mutex)
+    struct PendingFrame
+    {
+        std::uint64_t step;
+        std::vector<std::uint8_t> data;
+    };
+    std::deque<PendingFrame> m_pending;
+    std::vector<std::vector<std::uint8_t>> m_free;
+    std::size_t m_pending_bytes = 0;
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_closing = false;
+    bool m_failed = false;    // Une écriture du thread d'écriture a échoué
+    std::thread m_writer;
+};
+
+/**
+ * @brief Lecture d'un enregistrement : fichier projeté en mémoire (mmap), trames décodées à la demande.
+ *
+ * seek() amène les cartes à une trame quelconque : à partir de la trame courante si la cible la suit
+ * de près, sinon à partir de la dernière trame clé qui la précède. Les erreurs d'ouverture ou de format
+ * lèvent std::runtime_error.
+ */
+class Recording
+{
+public:
+    explicit Recording( std::string const& t_path );
+    Recording( Recording const & ) = delete;
+    ~Recording();
+
+    Recording& operator = ( Recording const & ) = delete;
+
+    RecordingHeader const& header() const { return m_header; }
+    std::size_t   nb_frames() const { return m_index.size(); }
+    std::uint64_t step( std::size_t t_frame ) const { return m_index[t_frame].step; }
+    // Première trame de pas au moins t_step (nb_frames() si aucune)
+    std::size_t   find( std::uint64_t t_step ) const;
+
+    // Décode jusqu'à la trame t_frame ; renvoie faux si une trame est mal formée
+    bool seek( std::size_t t_frame );
+    // Trame décodée courante (nb_frames() avant le premier seek())
+    std::size_t frame() const { return m_frame; }
+    MapView vegetation() const { return m_decoder.vegetation(); }
+    MapView fire() const { return m_decoder.fire(); }
+
+private:
+    void rebuild_index();
+
+    std::uint8_t const* m_data = nullptr;
+    std::size_t m_size = 0;
+    RecordingHeader m_header;
+    std::vector<RecordingIndexEntry> m_index;
+    FrameDecoder m_decoder;
+    std::size_t m_frame;
+};
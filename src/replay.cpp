@@ -0,0 +1,170 @@
+#include <string>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <SDL2/SDL.h>
+#include "recording.hpp"
+#include "display.hpp"
+
+// Relecture d'un enregistrement (RecordingSink) : le fichier est projeté en mémoire et les trames sont
+// décodées à la demande, à la vitesse choisie. Touches : espace (pause), flèches gauche/droite en pause
+// (trame précédente/suivante), Début (retour au début), Page préc./suiv. (saut d'un intervalle de
+// trames clés) ; molette, +/-, glisser pour la vue.
+struct ParamsType {
+    std::string path;
+    double speed{60.};           // Pas simulés par seconde de relecture
+    double fps{30.};             // Cadence d'affichage visée (images par seconde)
+    std::uint64_t from{0};       // Premier pas relu
+    bool display{true};          // Sans affichage : décodage de toutes les trames, au plus vite
+    Displayer::Mode renderer{Displayer::Mode::texture};
+};
+
+bool analyze_arg(int nargs, char* args[], ParamsType& params) {
+    for (int i = 1; i < nargs; ++i) {
+        std::string arg = args[i];
+        if (arg == "--speed" && i + 1 < nargs) {
+            params.speed = std::stod(args[++i]);
+        }
+        else if (arg == "--fps" && i + 1 < nargs) {
+            params.fps = std::stod(args[++i]);
+        }
+        else if (arg == "--from" && i + 1 < nargs) {
+            params.from = std::stoull(args[++i]);
+        }
+        else if (arg == "--no-display") {
+            params.display = false;
+        }
+        else if (arg == "--renderer" && i + 1 < nargs) {
+            params.renderer = std::string(args[++i]) == "rectangles" ? Displayer::Mode::rectangles : Displayer::Mode::texture;
+        }
+        else if (arg[0] != '-' && params.path.empty()) {
+            params.path = arg;
+        }
+        else {
+            std::cerr << "[ERREUR] Option inconnue ou incomplète : " << arg << std::endl;
+            return false;
+        }
+    }
+    if (params.path.empty() || params.speed <= 0 || params.fps <= 0) {
+        std::cerr << "Usage : " << args[0] << " fichier [--speed pas/s] [--fps images/s] [--from pas]"
+                  << " [--renderer texture|rectangles] [--no-display]" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Décodage de toutes les trames, sans affichage : débit de relecture
+int decode_all(Recording& recording) {
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t frame = 0; frame < recording.nb_frames(); ++frame) {
+        if (!recording.seek(frame)) {
+            std::cerr << "[ERREUR] Trame " << frame << " invalide." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Trames décodées : " << recording.nb_frames() << " en " << seconds << " s ("
+              << recording.nb_frames() / seconds << " trames/s)" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int main(int nargs, char* args[]) {
+    ParamsType params;
+    if (!analyze_arg(nargs, args, params))
+        return EXIT_FAILURE;
+
+    try {
+        Recording recording(params.path);
+        RecordingHeader const& header = recording.header();
+        std::cout << "Enregistrement : " << params.path << std::endl;
+        std::cout << "  Discrétisation : " << header.width << " x " << header.height << std::endl;
+        std::cout << "  Longueur du terrain : " << header.length << " - vent : [" << header.wind[0] << ", "
+                  << header.wind[1] << "] - graine : " << header.seed << std::endl;
+        std::cout << "  Trames : " << recording.nb_frames() << " (trame clé toutes les " << header.keyframe_interval
+                  << ")" << (header.index_offset == 0 ? " - index reconstruit" : "") << std::endl;
+        if (recording.nb_frames() == 0)
+            return EXIT_SUCCESS;
+        if (!params.display)
+            return decode_all(recording);
+
+        const int window = Displayer::window_size(int(header.width), 5);
+        auto displayer = Displayer::createOrGetInstance(window, window);
+        displayer->set_mode(params.renderer);
+        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(1.0 / params.fps));
+        const std::size_t last_frame = recording.nb_frames() - 1;
+        const std::size_t jump = std::max<std::size_t>(header.keyframe_interval, 1);
+
+        // Position de lecture en pas simulés : elle avance de params.speed pas par seconde, sauf en pause.
+        // La trame affichée est la dernière dont le pas ne dépasse pas la position.
+        auto frame_at = [&](double step) {
+            std::size_t next = recording.find(std::uint64_t(std::max(step, 0.)) + 1);
+            return next == 0 ? 0 : std::min(next - 1, last_frame);
+        };
+        double position = double(std::max(params.from, recording.step(0)));
+        bool paused = false, quit = false, redraw = true;
+        std::size_t nb_displayed = 0;
+        auto previous = std::chrono::steady_clock::now();
+        while (!quit) {
+            std::size_t target = frame_at(position);
+            SDL_Event event;
+            while (SDL_PollEvent(&event)) {
+                if (event.type == SDL_QUIT) {
+                    quit = true;
+                }
+                else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_SPACE) {
+                    paused = !paused;
+                }
+                else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_HOME) {
+                    target = 0;
+                }
+                else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_PAGEDOWN) {
+                    target = std::min(target + jump, last_frame);
+                }
+                else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_PAGEUP) {
+                    target = target > jump ? target - jump : 0;
+                }
+                else if (paused && event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_RIGHT) {
+                    target = std::min(target + 1, last_frame);
+                }
+                else if (paused && event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_LEFT) {
+                    target = target > 0 ? target - 1 : 0;
+                }
+                else if (displayer->handle_event(event)) {
+                    redraw = true;
+                }
+                // Un saut replace la position de lecture sur la trame visée
+                if (target != frame_at(position))
+                    position = double(recording.step(target));
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (!paused)
+                position += params.speed * std::chrono::duration<double>(now - previous).count();
+            previous = now;
+            target = frame_at(position);
+            if (target != recording.frame()) {
+                if (!recording.seek(target)) {
+                    std::cerr << "[ERREUR] Trame " << target << " invalide." << std::endl;
+                    return EXIT_FAILURE;
+                }
+                redraw = true;
+            }
+            if (redraw && !quit) {
+                displayer->update(recording.vegetation(), recording.fire());
+                redraw = false;
+                nb_displayed++;
+            }
+            std::this_thread::sleep_until(now + period);
+        }
+        std::cout << "Images affichées : " << nb_displayed << std::endl;
+    }
+    catch (std::exception const& error) {
+        std::cerr << "[ERREUR] " << error.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
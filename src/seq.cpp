@@ -1,7 +1,30 @@
 #include <string>
 #include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <new>
+#include <iostream>
 #include "model.hpp"
 
+// Compteur d'allocations dynamiques : permet de vérifier qu'un pas de temps en régime
+// établi ne fait aucune allocation sur le tas.
+namespace
+{
+    std::size_t nb_allocations = 0;
+}
+
+void* operator new( std::size_t size )
+{
+    ++nb_allocations;
+    if (void* ptr = std::malloc(size > 0 ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+void operator delete( void* ptr ) noexcept { std::free(ptr); }
+void operator delete( void* ptr, std::size_t ) noexcept { std::free(ptr); }
+
 struct ParamsType {
     double length{10.};
     unsigned discretization{300u};
@@ -9,20 +32,78 @@ struct ParamsType {
     Model::LexicoIndices start{10u,10u};
 };
 
-int main() {
-    ParamsType params;
-    auto simu = Model(params.length, params.discretization, 
-                     params.wind, params.start);
+struct PassResult {
+    int iterations{0};
+    double update_ms{0.};
+    std::size_t allocations{0}, steps_with_allocations{0};
+    std::size_t max_front{0};
+};
+
+// Simulation jusqu'à l'extinction ou MAX_ITERATIONS pas, en comptant les allocations faites par update()
+PassResult run_pass(Model& simu) {
     const int MAX_ITERATIONS = 200;
-    int iteration = 0;
-    
-    while(simu.update() && iteration < MAX_ITERATIONS) {
-        std::vector<Model::LexicoIndices> front_indices;
-        for (const auto& pair : simu.m_fire_front) {
+    PassResult result;
+    auto update_time = std::chrono::high_resolution_clock::duration::zero();
+    std::vector<Model::LexicoIndices> front_indices;
+
+    bool running = true;
+    while(running && result.iterations < MAX_ITERATIONS) {
+        std::size_t allocations_before = nb_allocations;
+        auto step_start = std::chrono::high_resolution_clock::now();
+        running = simu.update();
+        update_time += std::chrono::high_resolution_clock::now() - step_start;
+        if (nb_allocations != allocations_before) {
+            result.allocations += nb_allocations - allocations_before;
+            result.steps_with_allocations++;
+        }
+
+        front_indices.clear();
+        for (auto cell : simu.fire_front()) {
             front_indices.push_back(
-                simu.get_lexicographic_from_index(pair.first));
+                simu.get_lexicographic_from_index(cell.index));
         }
-        iteration++;
+        result.max_front = std::max(result.max_front, simu.fire_front().size());
+        result.iterations++;
     }
-    return 0;
-}
\ No newline at end of file
+    result.update_ms = std::chrono::duration<double, std::milli>(update_time).count();
+    return result;
+}
+
+// Première simulation : les tampons grandissent avec le front. Leur capacité double à chaque
+// réallocation : le nombre de pas qui allouent doit rester logarithmique en la taille du front.
+// Seconde simulation identique après reset() : les tampons ont déjà leur taille, aucun pas ne doit allouer.
+bool run_simulation(Model::Engine engine, char const* name) {
+    ParamsType params;
+    auto simu = Model(params.length, params.discretization,
+                     params.wind, params.start);
+    simu.set_engine(engine);
+    PassResult growth = run_pass(simu);
+    simu.reset(params.wind, params.start, 0);
+    PassResult steady = run_pass(simu);
+
+    std::cout << "[" << name << "] Pas de temps : " << growth.iterations
+              << " - Temps moyen par update : " << growth.update_ms / growth.iterations << " ms"
+              << " - Taille finale du front : " << simu.fire_front().size() << std::endl;
+    std::cout << "[" << name << "] Allocations dans update : " << growth.allocations
+              << " réparties sur " << growth.steps_with_allocations << " pas (croissance du front), "
+              << steady.allocations << " en régime établi (après reset)" << std::endl;
+    const std::size_t growth_bound = 4*std::size_t(std::ceil(std::log2(double(growth.max_front) + 1.)));
+    bool ok = true;
+    if (growth.steps_with_allocations > growth_bound) {
+        std::cerr << "[ERREUR] [" << name << "] " << growth.steps_with_allocations << " pas allouent pendant la"
+                  << " croissance du front (au plus " << growth_bound << " attendus)." << std::endl;
+        ok = false;
+    }
+    if (steady.allocations != 0) {
+        std::cerr << "[ERREUR] [" << name << "] " << steady.steps_with_allocations
+                  << " pas allouent en régime établi." << std::endl;
+        ok = false;
+    }
+    return ok;
+}
+
+int main() {
+    bool steady = run_simulation(Model::Engine::sparse, "sparse");
+    steady = run_simulation(Model::Engine::dense, "dense") && steady;
+    return steady ? 0 : 1;
+}
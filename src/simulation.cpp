@@ -4,11 +4,21 @@
 #include <thread>
 #include <chrono>
 #include <vector>
+#include <algorithm>
+#include <stdexcept>
 #include <cassert>
 #include <mpi.h>
 #include "simulation.hpp"
-#include "display.hpp"
+#include <memory>
+#include "display_sink.hpp"
+#include "frame_sink.hpp"
+#include "recording.hpp"
 #include "model.hpp"
+#include "frame_stream.hpp"
+
+// Étiquettes des messages entre le processus d'affichage (0) et le processus de calcul (1) : un message
+// par pas (état du calcul et trame), et la demande d'arrêt de l'affichage
+constexpr int tag_frame = 1, tag_stop = 3;
 
 bool analyze_args(int nargs, char* argv[], ParamsType& params)
 {
@@ -23,7 +33,7 @@ bool analyze_args(int nargs, char* argv[], ParamsType& params)
             }
             else
             {
-                std::cerr << "Missing value for " << arg << std::endl;
+                std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
                 return false;
             }
         }
@@ -35,7 +45,7 @@ bool analyze_args(int nargs, char* argv[], ParamsType& params)
             }
             else
             {
-                std::cerr << "Missing value for " << arg << std::endl;
+                std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
                 return false;
             }
         }
@@ -48,7 +58,7 @@ bool analyze_args(int nargs, char* argv[], ParamsType& params)
             }
             else
             {
-                std::cerr << "Missing values for " << arg << std::endl;
+                std::cerr << "[ERREUR] Valeurs manquantes pour " << arg << std::endl;
                 return false;
             }
         }
@@ -61,13 +71,119 @@ bool analyze_args(int nargs, char* argv[], ParamsType& params)
             }
             else
             {
-                std::cerr << "Missing values for " << arg << std::endl;
+                std::cerr << "[ERREUR] Valeurs manquantes pour " << arg << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "-e" || arg == "--engine")
+        {
+            if (i + 1 < nargs)
+            {
+                std::string name = argv[++i];
+                if (name == "sparse")
+                    params.engine = Model::Engine::sparse;
+                else if (name == "dense")
+                    params.engine = Model::Engine::dense;
+                else
+                {
+                    std::cerr << "[ERREUR] Moteur inconnu : " << name << " (sparse ou dense)" << std::endl;
+                    return false;
+                }
+            }
+            else
+            {
+                std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--fps")
+        {
+            if (i + 1 < nargs)
+            {
+                params.fps = std::stod(argv[++i]);
+            }
+            else
+            {
+                std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--renderer")
+        {
+            if (i + 1 < nargs)
+            {
+                std::string name = argv[++i];
+                if (name == "texture")
+                    params.renderer = Displayer::Mode::texture;
+                else if (name == "rectangles")
+                    params.renderer = Displayer::Mode::rectangles;
+                else
+                {
+                    std::cerr << "[ERREUR] Rendu inconnu : " << name << " (texture ou rectangles)" << std::endl;
+                    return false;
+                }
+            }
+            else
+            {
+                std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--no-display")
+        {
+            params.display = false;
+        }
+        else if (arg == "--snapshot")
+        {
+            if (i + 1 < nargs)
+            {
+                params.snapshot_interval = std::stoul(argv[++i]);
+            }
+            else
+            {
+                std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--snapshot-prefix")
+        {
+            if (i + 1 < nargs)
+            {
+                params.snapshot_prefix = argv[++i];
+            }
+            else
+            {
+                std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--record")
+        {
+            if (i + 1 < nargs)
+            {
+                params.record = argv[++i];
+            }
+            else
+            {
+                std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--seed")
+        {
+            if (i + 1 < nargs)
+            {
+                params.seed = std::stoull(argv[++i]);
+            }
+            else
+            {
+                std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
                 return false;
             }
         }
         else
         {
-            std::cerr << "Unknown argument: " << arg << std::endl;
+            std::cerr << "[ERREUR] Option inconnue : " << arg << std::endl;
             return false;
         }
     }
@@ -78,17 +194,22 @@ bool check_params(const ParamsType& params)
 {
     if (params.length <= 0)
     {
-        std::cerr << "Length must be positive" << std::endl;
+        std::cerr << "[ERREUR] La longueur doit être positive." << std::endl;
         return false;
     }
     if (params.discretization <= 0)
     {
-        std::cerr << "Discretization must be positive" << std::endl;
+        std::cerr << "[ERREUR] La discrétisation doit être positive." << std::endl;
+        return false;
+    }
+    if (params.fps <= 0)
+    {
+        std::cerr << "[ERREUR] La cadence d'affichage doit être positive." << std::endl;
         return false;
     }
     if (params.start[0] < 0 || params.start[0] > 1 || params.start[1] < 0 || params.start[1] > 1)
     {
-        std::cerr << "Start position must be between 0 and 1" << std::endl;
+        std::cerr << "[ERREUR] La position du foyer doit être entre 0 et 1." << std::endl;
         return false;
     }
     return true;
@@ -103,7 +224,7 @@ int main(int nargs, char* argv[])
 
     if (size != 2) {
         if (rank == 0)
-            std::cerr << "Ce programme doit être exécuté avec exactement 2 processus MPI" << std::endl;
+            std::cerr << "[ERREUR] Ce programme doit être exécuté avec exactement 2 processus MPI." << std::endl;
         MPI_Finalize();
         return EXIT_FAILURE;
     }
@@ -125,37 +246,100 @@ int main(int nargs, char* argv[])
         std::cout << "  Discrétisation : " << params.discretization << std::endl;
         std::cout << "  Vent : (" << params.wind[0] << ", " << params.wind[1] << ")" << std::endl;
         std::cout << "  Position initiale du foyer : (" << params.start[0] << ", " << params.start[1] << ")" << std::endl;
+        std::cout << "  Moteur : " << (params.engine == Model::Engine::dense ? "dense" : "sparse") << std::endl;
+        std::cout << "  Graine : " << params.seed << std::endl;
+        std::cout << "  Rendu : " << (params.display ? (params.renderer == Displayer::Mode::texture ? "texture" : "rectangles")
+                                                     : "aucun") << std::endl;
+        if (params.snapshot_interval > 0)
+            std::cout << "  Images : " << params.snapshot_prefix << "_*.ppm tous les " << params.snapshot_interval << " pas" << std::endl;
+        if (!params.record.empty())
+            std::cout << "  Enregistrement : " << params.record << std::endl;
         std::cout << std::endl;
 
-        auto displayer = Displayer::createOrGetInstance(params.discretization * 5, params.discretization * 5);
-        std::vector<std::uint8_t> veg_buffer(params.discretization * params.discretization);
-        std::vector<std::uint8_t> fire_buffer(params.discretization * params.discretization);
-        bool running = true;
-
-        while (running) {
-            SDL_Event event;
-            while (SDL_PollEvent(&event)) {
-                if (event.type == SDL_QUIT) {
-                    running = false;
-                    MPI_Send(&running, 1, MPI_CXX_BOOL, 1, 3, MPI_COMM_WORLD);
-                    break;
-                }
+        // Destinations des trames : la fenêtre (de taille bornée : au-delà, l'affichage réduit la grille),
+        // des images périodiques, un enregistrement. L'enregistrement reçoit chaque trame appliquée, les
+        // autres destinations seulement la plus récente.
+        std::vector<std::unique_ptr<FrameSink>> sinks;
+        FrameSink* display = nullptr;
+        FrameSink* snapshots = nullptr;
+        std::unique_ptr<RecordingSink> recorder;
+        if (params.display) {
+            sinks.push_back(std::make_unique<DisplaySink>(Displayer::window_size(params.discretization, 5),
+                                                          params.renderer, params.fps));
+            display = sinks.back().get();
+        }
+        if (params.snapshot_interval > 0) {
+            sinks.push_back(std::make_unique<SnapshotSink>(params.snapshot_prefix, params.snapshot_interval,
+                                                           params.discretization, params.discretization));
+            snapshots = sinks.back().get();
+        }
+        if (!params.record.empty()) {
+            try {
+                recorder = std::make_unique<RecordingSink>(params.record, params.discretization, params.discretization,
+                                                           params.length, params.wind, params.seed);
             }
-            if (!running) break;
+            catch (std::exception const& error) {
+                std::cerr << "[ERREUR] " << error.what() << std::endl;
+                MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+            }
+        }
+        const std::size_t nb_cells = std::size_t(params.discretization) * params.discretization;
+        const auto start = std::chrono::steady_clock::now();
+        std::size_t written_frame = 0;
+        bool stop_sent = false;
+        std::size_t nb_frames = 0;
+        double compute_seconds = 0.;
+        bool finished = false;
+        {
+            // Les trames sont appliquées dès leur arrivée et la plus récente est transmise aux destinations,
+            // qui choisissent celles qu'elles traitent. Le calcul ne ralentit jamais pour elles.
+            FrameReceiver receiver(MPI_COMM_WORLD, 1, tag_frame, nb_cells);
+            while (!finished) {
+                bool stop = false;
+                for (auto& sink : sinks)
+                    stop = sink->poll() || stop;
+                if (stop && !stop_sent) {
+                    // Le calcul s'arrête puis marque son dernier message : on continue à recevoir jusque-là
+                    MPI_Send(&stop, 1, MPI_CXX_BOOL, 1, tag_stop, MPI_COMM_WORLD);
+                    stop_sent = true;
+                }
 
-            MPI_Status status;
-            int flag;
-            MPI_Iprobe(1, 0, MPI_COMM_WORLD, &flag, &status);
-            if (flag) {
-                MPI_Recv(&running, 1, MPI_CXX_BOOL, 1, 0, MPI_COMM_WORLD, &status);
-                if (!running) break;
+                // Les messages arrivent dans l'ordre d'envoi : le dernier clôt la réception
+                receiver.poll(recorder.get());
+                finished = receiver.finished();
 
-                MPI_Recv(veg_buffer.data(), veg_buffer.size(), MPI_UINT8_T, 1, 1, MPI_COMM_WORLD, &status);
-                MPI_Recv(fire_buffer.data(), fire_buffer.size(), MPI_UINT8_T, 1, 2, MPI_COMM_WORLD, &status);
-                
-                displayer->update(veg_buffer, fire_buffer);
+                if (receiver.received() > written_frame) {
+                    for (auto& sink : sinks)
+                        sink->write(receiver.header().step, receiver.vegetation(), receiver.fire(), finished);
+                    written_frame = receiver.received();
+                }
+                else if (!finished) {
+                    // Pas de nouvelle trame : courte attente du processus de réception seul
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+            nb_frames = receiver.received();
+            compute_seconds = receiver.header().total_seconds;
+        }
+        std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
+        std::cout << "Temps de calcul annoncé : " << compute_seconds << " secondes" << std::endl;
+        std::cout << "Trames reçues : " << nb_frames;
+        if (display)
+            std::cout << " - images affichées : " << display->written()
+                      << " (" << display->written() / elapsed_seconds.count() << " images/s)";
+        if (snapshots)
+            std::cout << " - images enregistrées : " << snapshots->written();
+        std::cout << std::endl;
+        if (recorder) {
+            try {
+                recorder->close();
+            }
+            catch (std::exception const& error) {
+                std::cerr << "[ERREUR] " << error.what() << std::endl;
+                MPI_Finalize();
+                return EXIT_FAILURE;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            std::cout << "Enregistrement : " << recorder->written() << " trames, " << recorder->bytes() << " octets" << std::endl;
         }
     }
     else {
@@ -164,37 +348,50 @@ int main(int nargs, char* argv[])
                          params.wind,
                          {static_cast<unsigned int>(params.start[0] * params.discretization), 
                           static_cast<unsigned int>(params.start[1] * params.discretization)},
-                         10.0);  // Augmentation de la vitesse maximale du vent pour une meilleure propagation
+                         10.0,  // Augmentation de la vitesse maximale du vent pour une meilleure propagation
+                         params.seed);
+        simu.set_engine(params.engine);
 
         std::chrono::time_point<std::chrono::system_clock> start, end;
         start = std::chrono::system_clock::now();
 
+        std::size_t nb_steps = 0;
+        FrameSender sender(MPI_COMM_WORLD, 0, tag_frame, std::size_t(params.discretization) * params.discretization);
+        StepHeader header;
         bool running = true;
         while (running) {
             int flag;
-            MPI_Status status;
-            MPI_Iprobe(0, 3, MPI_COMM_WORLD, &flag, &status);
+            MPI_Iprobe(0, tag_stop, MPI_COMM_WORLD, &flag, MPI_STATUS_IGNORE);
             if (flag) {
-                MPI_Recv(&running, 1, MPI_CXX_BOOL, 0, 3, MPI_COMM_WORLD, &status);
+                bool stop;
+                MPI_Recv(&stop, 1, MPI_CXX_BOOL, 0, tag_stop, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
                 break;
             }
 
+            auto step_start = std::chrono::steady_clock::now();
             running = simu.update();
-            MPI_Send(&running, 1, MPI_CXX_BOOL, 0, 0, MPI_COMM_WORLD);
-            
-            if (running) {
-                auto veg_map = simu.vegetal_map();
-                auto fire_map = simu.fire_map();
-                MPI_Send(veg_map.data(), veg_map.size(), MPI_UINT8_T, 0, 1, MPI_COMM_WORLD);
-                MPI_Send(fire_map.data(), fire_map.size(), MPI_UINT8_T, 0, 2, MPI_COMM_WORLD);
-            }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            header.step_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - step_start).count();
+            header.total_seconds += header.step_seconds;
+            header.step = simu.time_step();
+            nb_steps++;
+            // Trame sautée si les deux précédentes sont encore en cours d'envoi
+            sender.send(header, simu.vegetal_map(), simu.fire_map());
         }
-
         end = std::chrono::system_clock::now();
+
+        // L'état final est toujours transmis, dans le dernier message
+        sender.flush();
+        header.running = 0;
+        sender.send(header, simu.vegetal_map(), simu.fire_map());
+        sender.flush();
+
         std::chrono::duration<double> elapsed_seconds = end - start;
-        std::cout << "Temps pour la simulation : " << elapsed_seconds.count() << " secondes" << std::endl;
+        std::cout << "Temps pour la simulation : " << elapsed_seconds.count() << " secondes - "
+                  << nb_steps << " pas (" << nb_steps / elapsed_seconds.count() << " pas/s)" << std::endl;
+        std::cout << "Trames envoyées : " << sender.sent() << ", sautées : " << sender.skipped()
+                  << " - volume moyen : " << sender.sent_bytes() / std::max<std::size_t>(sender.sent(), 1)
+                  << " octets (cartes complètes : " << 2 * params.discretization * params.discretization
+                  << " octets)" << std::endl;
     }
 
     MPI_Finalize();
@@ -2,6 +2,10 @@
 #define _SIMULATION_HPP_
 
 #include <array>
+#include <cstdint>
+#include <string>
+#include "model.hpp"
+#include "display.hpp"
 
 struct ParamsType
 {
@@ -9,6 +13,14 @@ struct ParamsType
     int discretization = 100;
     std::array<double,2> wind = {0.0, 0.0};
     std::array<double,2> start = {0.5, 0.5};
+    Model::Engine engine = Model::Engine::sparse;
+    std::uint64_t seed = 0;
+    double fps = 30.0;  // Cadence d'affichage visée (images par seconde)
+    Displayer::Mode renderer = Displayer::Mode::texture;
+    bool display = true;  // Fenêtre SDL (--no-display : calcul seul, sans fenêtre)
+    unsigned snapshot_interval = 0;  // Image PPM tous les snapshot_interval pas (0 : aucune)
+    std::string snapshot_prefix = "snapshot";  // Fichiers <préfixe>_<pas>.ppm
+    std::string record;  // Enregistrement des trames reçues (relu par replay.exe), vide : aucun
 };
 
 bool analyze_args(int nargs, char* argv[], ParamsType& params);
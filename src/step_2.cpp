@@ -10,6 +10,7 @@
 #include <SDL2/SDL.h>
 #include "model.hpp"
 #include "display.hpp"
+#include "frame_stream.hpp"
 
 // --- Fonctions de parsing d'arguments (exemple minimal) ---
 struct ParamsType {
@@ -17,6 +18,7 @@ struct ParamsType {
     unsigned discretization{300u};
     std::array<double,2> wind{0.,0.};
     Model::LexicoIndices start{10u,10u};
+    double fps{30.}; // Cadence d'affichage visée (images par seconde)
 };
 
 void analyze_arg(int nargs, char* args[], ParamsType& params) {
@@ -71,60 +73,70 @@ int main(int argc, char* argv[]) {
 
     if (rank == 0) {
         // --- Processus 0 : Affichage ---
-        std::shared_ptr<Displayer> displayer = Displayer::init_instance(params.discretization, params.discretization);
-        std::vector<std::uint8_t> global_vegetal(grid_size);
-        std::vector<std::uint8_t> global_fire(grid_size);
-        bool running = true;
+        const int window = Displayer::window_size(params.discretization, 1);
+        std::shared_ptr<Displayer> displayer = Displayer::createOrGetInstance(window, window);
+        bool stop_sent = false, finished = false;
         unsigned display_count = 0;
+        std::size_t nb_frames = 0, displayed_frame = 0;
+        std::uint64_t reported_step = 0;
         auto total_display_time = std::chrono::high_resolution_clock::duration::zero();
-
-        while (running) {
-            SDL_Event event;
-            while (SDL_PollEvent(&event)) {
-                if (event.type == SDL_QUIT) {
-                    running = false;
+        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(1.0 / params.fps));
+        auto next_display = std::chrono::steady_clock::now();
+
+        {
+            // Les trames sont appliquées dès leur arrivée, la plus récente est affichée au plus
+            // params.fps fois par seconde : le calcul n'attend jamais l'affichage
+            FrameReceiver receiver(MPI_COMM_WORLD, 1, 0, grid_size);
+            while (!finished) {
+                SDL_Event event;
+                while (SDL_PollEvent(&event)) {
+                    if (event.type == SDL_QUIT && !stop_sent) {
+                        // Le calcul s'arrête puis marque son dernier message : on reçoit jusque-là
+                        int termination_signal = 0;
+                        MPI_Send(&termination_signal, 1, MPI_INT, 1, 2, MPI_COMM_WORLD);
+                        stop_sent = true;
+                    }
                 }
-            }
-            if (!running) break;
-
-            int flag = 0;
-            MPI_Iprobe(1, 0, MPI_COMM_WORLD, &flag, MPI_STATUS_IGNORE);
-            if (flag) {
-                MPI_Recv(global_vegetal.data(), grid_size, MPI_UNSIGNED_CHAR, 1, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                MPI_Recv(global_fire.data(), grid_size, MPI_UNSIGNED_CHAR, 1, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
 
-                auto display_start = std::chrono::high_resolution_clock::now();
-                displayer->update(global_vegetal, global_fire);
-                auto display_end = std::chrono::high_resolution_clock::now();
-                total_display_time += (display_end - display_start);
-                display_count++;
+                receiver.poll();
+                finished = receiver.finished();
 
-                // Tous les 32 affichages, on affiche les temps
-                if (display_count % 32 == 0) {
-                    double total_sim_ms = 0.0;
-                    MPI_Recv(&total_sim_ms, 1, MPI_DOUBLE, 1, 4, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                // Temps de calcul cumulé, transmis dans l'en-tête de chaque trame : bilan tous les 32 pas
+                if (receiver.header().step / 32 > reported_step / 32) {
+                    reported_step = receiver.header().step;
+                    double total_sim_ms = receiver.header().total_seconds * 1000.0;
 
                     double total_display_ms = std::chrono::duration_cast<std::chrono::milliseconds>(total_display_time).count();
                     double total_time_s = MPI_Wtime() - total_start_time;  // Temps global depuis le début
 
-                    std::cout << "\n=== Iteration " << display_count << " ===" << std::endl;
+                    std::cout << "\n=== Trame " << receiver.received() << " - image " << display_count << " ===" << std::endl;
                     std::cout << "[Affichage] Temps total partie affichage : " << total_display_ms / 1000.0 << " secondes" << std::endl;
                     std::cout << "[Simulation] Temps total partie calcul : " << total_sim_ms / 1000.0 << " secondes" << std::endl;
                     std::cout << "[Simulation] Temps total simulation : " << total_time_s << " secondes" << std::endl;
                 }
-            } else {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+                auto now = std::chrono::steady_clock::now();
+                if (receiver.received() > displayed_frame && !stop_sent && (now >= next_display || finished)) {
+                    auto display_start = std::chrono::high_resolution_clock::now();
+                    displayer->update(receiver.vegetation(), receiver.fire());
+                    total_display_time += std::chrono::high_resolution_clock::now() - display_start;
+                    displayed_frame = receiver.received();
+                    display_count++;
+                    next_display = now + period;
+                } else if (!finished) {
+                    std::this_thread::sleep_until(std::min(next_display, now + std::chrono::milliseconds(1)));
+                }
             }
+            nb_frames = receiver.received();
         }
 
-        // Envoi du signal de terminaison
-        int termination_signal = 0;
-        MPI_Send(&termination_signal, 1, MPI_INT, 1, 2, MPI_COMM_WORLD);
-
         // Affichage final
         double total_time_s = MPI_Wtime() - total_start_time;
         std::cout << "\n=== Résultats globaux ===" << std::endl;
         std::cout << "[Simulation Globale] Temps total : " << total_time_s << " secondes" << std::endl;
+        std::cout << "[Affichage] " << display_count << " images affichées (" << display_count / total_time_s
+                  << " images/s) pour " << nb_frames << " trames reçues" << std::endl;
     }
     else if (rank == 1) {
         // --- Processus 1 : Simulation ---
@@ -133,33 +145,43 @@ int main(int argc, char* argv[]) {
         unsigned step_count = 0;
         auto total_sim_time = std::chrono::high_resolution_clock::duration::zero();
 
-        while (simulation_continue) {
-            auto step_start = std::chrono::high_resolution_clock::now();
-            simulation_continue = simu.update();
-            auto step_end = std::chrono::high_resolution_clock::now();
-            total_sim_time += (step_end - step_start);
-            step_count++;
-
-            std::vector<std::uint8_t> local_veg = simu.vegetal_map();
-            std::vector<std::uint8_t> local_fire = simu.fire_map();
-            MPI_Send(local_veg.data(), grid_size, MPI_UNSIGNED_CHAR, 0, 0, MPI_COMM_WORLD);
-            MPI_Send(local_fire.data(), grid_size, MPI_UNSIGNED_CHAR, 0, 1, MPI_COMM_WORLD);
-
-            // ENVOYER le temps total de simulation toutes les 32 itérations
-            if (step_count % 32 == 0) {
-                double total_sim_ms = std::chrono::duration_cast<std::chrono::milliseconds>(total_sim_time).count();
-                MPI_Send(&total_sim_ms, 1, MPI_DOUBLE, 0, 4, MPI_COMM_WORLD);
-            }
-
-            int flag = 0;
-            MPI_Iprobe(0, 2, MPI_COMM_WORLD, &flag, MPI_STATUS_IGNORE);
-            if (flag) {
-                int term;
-                MPI_Recv(&term, 1, MPI_INT, 0, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                simulation_continue = false;
+        {
+            // Une trame par pas, sautée si les deux précédentes sont encore en cours d'envoi
+            FrameSender sender(MPI_COMM_WORLD, 0, 0, grid_size);
+            StepHeader header;
+            while (simulation_continue) {
+                auto step_start = std::chrono::high_resolution_clock::now();
+                simulation_continue = simu.update();
+                auto step_end = std::chrono::high_resolution_clock::now();
+                total_sim_time += (step_end - step_start);
+                step_count++;
+
+                // Le temps de calcul accompagne la trame, dans l'en-tête du message du pas
+                header.step = simu.time_step();
+                header.step_seconds = std::chrono::duration<double>(step_end - step_start).count();
+                header.total_seconds = std::chrono::duration<double>(total_sim_time).count();
+                sender.send(header, simu.vegetal_map(), simu.fire_map());
+
+                int flag = 0;
+                MPI_Iprobe(0, 2, MPI_COMM_WORLD, &flag, MPI_STATUS_IGNORE);
+                if (flag) {
+                    int term;
+                    MPI_Recv(&term, 1, MPI_INT, 0, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                    simulation_continue = false;
+                }
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            // L'état final est toujours transmis, dans le dernier message
+            sender.flush();
+            header.running = 0;
+            sender.send(header, simu.vegetal_map(), simu.fire_map());
+            sender.flush();
+
+            double sim_s = std::chrono::duration<double>(total_sim_time).count();
+            std::cout << "[Simulation] " << step_count << " pas (" << step_count / sim_s << " pas/s) - trames envoyées : "
+                      << sender.sent() << ", sautées : " << sender.skipped() << " - volume moyen : "
+                      << sender.sent_bytes() / sender.sent() << " octets (cartes complètes : " << 2 * grid_size
+                      << " octets)" << std::endl;
         }
     }
 
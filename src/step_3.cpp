@@ -1,5 +1,4 @@
 #include <mpi.h>
-#include <omp.h>
 #include <iostream>
 #include <cstdlib>
 #include <chrono>
@@ -11,6 +10,7 @@
 #include <SDL2/SDL.h>
 #include "model.hpp"
 #include "display.hpp"
+#include "frame_stream.hpp"
 
 // --- Fonctions de parsing d'arguments (exemple minimal) ---
 struct ParamsType
@@ -19,6 +19,7 @@ struct ParamsType
     unsigned discretization{300u};
     std::array<double, 2> wind{0., 0.};
     Model::LexicoIndices start{10u, 10u};
+    double fps{30.}; // Cadence d'affichage visée (images par seconde)
 };
 
 void analyze_arg(int nargs, char* args[], ParamsType& params) {
@@ -119,61 +120,72 @@ int main(int argc, char *argv[])
     if (rank == 0)
     {
         // Processus d'affichage (SDL)
-        std::shared_ptr<Displayer> displayer = Displayer::init_instance(params.discretization * SCALE, params.discretization * SCALE);
-        std::vector<std::uint8_t> global_vegetal(grid_size);
-        std::vector<std::uint8_t> global_fire(grid_size);
-        bool running = true;
+        const int window = Displayer::window_size(params.discretization, SCALE);
+        std::shared_ptr<Displayer> displayer = Displayer::createOrGetInstance(window, window);
+        bool stop_sent = false;
+        bool finished = false;
         unsigned display_count = 0;
+        std::size_t nb_frames = 0, displayed_frame = 0;
         auto total_display_time = std::chrono::high_resolution_clock::duration::zero();
+        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(1.0 / params.fps));
+        const auto start = std::chrono::steady_clock::now();
+        auto next_display = start;
 
-        while (running)
         {
-            // Vérification immédiate des événements SDL
-            SDL_Event event;
-            while (SDL_PollEvent(&event))
+            // Réception en tâche de fond des trames (clés et deltas) : la plus récente est affichée
+            // au plus params.fps fois par seconde, le calcul n'attend jamais l'affichage
+            FrameReceiver receiver(MPI_COMM_WORLD, 1, 0, grid_size);
+            while (!finished)
             {
-                if (event.type == SDL_QUIT)
+                // Vérification immédiate des événements SDL
+                SDL_Event event;
+                while (SDL_PollEvent(&event))
                 {
-                    running = false;
+                    if (event.type == SDL_QUIT && !stop_sent)
+                    {
+                        // Demande d'arrêt : le calcul marque ensuite son dernier message
+                        int termination_signal = 0;
+                        MPI_Send(&termination_signal, 1, MPI_INT, 1, 2, MPI_COMM_WORLD);
+                        stop_sent = true;
+                    }
                 }
-            }
-            if (!running)
-            {
-                break;
-            }
 
-            // Utilisation de MPI_Iprobe pour vérifier la disponibilité des données
-            int flag = 0;
-            MPI_Iprobe(1, 0, MPI_COMM_WORLD, &flag, MPI_STATUS_IGNORE);
-            if (flag)
-            {
-                // Réception des données envoyées par le processus de calcul
-                MPI_Recv(global_vegetal.data(), grid_size, MPI_UNSIGNED_CHAR, 1, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                MPI_Recv(global_fire.data(), grid_size, MPI_UNSIGNED_CHAR, 1, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                // Messages reçus dans l'ordre d'envoi : le dernier clôt la réception
+                receiver.poll();
+                finished = receiver.finished();
 
-                auto display_start = std::chrono::high_resolution_clock::now();
-                displayer->update(global_vegetal, global_fire);
-                auto display_end = std::chrono::high_resolution_clock::now();
-                total_display_time += (display_end - display_start);
-                display_count++;
+                auto now = std::chrono::steady_clock::now();
+                if (receiver.received() > displayed_frame && !stop_sent && (now >= next_display || finished))
+                {
+                    auto display_start = std::chrono::high_resolution_clock::now();
+                    displayer->update(receiver.vegetation(), receiver.fire());
+                    auto display_end = std::chrono::high_resolution_clock::now();
+                    total_display_time += (display_end - display_start);
+                    displayed_frame = receiver.received();
+                    display_count++;
+                    next_display = now + period;
 
-                // Affichage de la moyenne tous les 32 affichages
-                if (display_count % 32 == 0)
+                    // Affichage de la moyenne tous les 32 affichages
+                    if (display_count % 32 == 0)
+                    {
+                        double avg_display_ms = std::chrono::duration_cast<std::chrono::milliseconds>(total_display_time).count() /
+                                                static_cast<double>(display_count);
+                        std::cout << "[AFFICHAGE] Moyenne du temps d'affichage : "
+                                  << avg_display_ms << " ms sur " << display_count << " itérations." << std::endl;
+                    }
+                }
+                else if (!finished)
                 {
-                    double avg_display_ms = std::chrono::duration_cast<std::chrono::milliseconds>(total_display_time).count() /
-                                            static_cast<double>(display_count);
-                    std::cout << "[AFFICHAGE] Moyenne du temps d'affichage : "
-                              << avg_display_ms << " ms sur " << display_count << " itérations." << std::endl;
+                    // Attente courte du seul processus d'affichage, jusqu'à la prochaine échéance
+                    std::this_thread::sleep_until(std::min(next_display, now + std::chrono::milliseconds(1)));
                 }
             }
-            else
-            {
-                // Attente courte si aucun message n'est disponible
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            }
+            nb_frames = receiver.received();
         }
 
         // Affichage final de la moyenne d'affichage
+        double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
         if (display_count > 0)
         {
             double avg_display_ms = std::chrono::duration_cast<std::chrono::milliseconds>(total_display_time).count() /
@@ -181,10 +193,8 @@ int main(int argc, char *argv[])
             std::cout << "[AFFICHAGE] Temps d'affichage final moyen : " << avg_display_ms
                       << " ms sur " << display_count << " itérations." << std::endl;
         }
-
-        // Envoi du signal de terminaison au processus de calcul
-        int termination_signal = 0;
-        MPI_Send(&termination_signal, 1, MPI_INT, 1, 2, MPI_COMM_WORLD);
+        std::cout << "[AFFICHAGE] " << display_count << " images affichées (" << display_count / elapsed_s
+                  << " images/s) pour " << nb_frames << " trames reçues." << std::endl;
     }
     else if (rank == 1)
     {
@@ -193,19 +203,15 @@ int main(int argc, char *argv[])
         bool simulation_continue = true;
         unsigned step_count = 0;
         auto total_sim_time = std::chrono::high_resolution_clock::duration::zero();
+        FrameSender sender(MPI_COMM_WORLD, 0, 0, grid_size);
+        StepHeader header;
 
         while (simulation_continue)
         {
             auto step_start = std::chrono::high_resolution_clock::now();
             
-            // Parallélisation OpenMP de l'update
-            #pragma omp parallel
-            {
-                #pragma omp single
-                {
-                    simulation_continue = simu.update();
-                }
-            }
+            // L'update répartit lui-même le front entre les threads OpenMP
+            simulation_continue = simu.update();
             
             auto step_end = std::chrono::high_resolution_clock::now();
             total_sim_time += (step_end - step_start);
@@ -219,14 +225,14 @@ int main(int argc, char *argv[])
                 std::cout << "[SIMULATION] Time step " << simu.time_step()
                           << " - Temps moyen de simulation : " << avg_sim_ms
                           << " ms sur " << step_count << " itérations."
-                          << " - Nombre de threads OpenMP : " << omp_get_max_threads() << std::endl;
+                          << " - Nombre de threads OpenMP : " << simu.threads() << std::endl;
             }
 
-            // Envoi des données de simulation vers le processus d'affichage
-            std::vector<std::uint8_t> local_veg = simu.vegetal_map();
-            std::vector<std::uint8_t> local_fire = simu.fire_map();
-            MPI_Send(local_veg.data(), grid_size, MPI_UNSIGNED_CHAR, 0, 0, MPI_COMM_WORLD);
-            MPI_Send(local_fire.data(), grid_size, MPI_UNSIGNED_CHAR, 0, 1, MPI_COMM_WORLD);
+            // Envoi non bloquant des cases modifiées ; trame sautée si l'affichage n'a pas suivi
+            header.step = simu.time_step();
+            header.step_seconds = std::chrono::duration<double>(step_end - step_start).count();
+            header.total_seconds = std::chrono::duration<double>(total_sim_time).count();
+            sender.send(header, simu.vegetal_map(), simu.fire_map());
 
             // Vérification non bloquante d'un signal de terminaison envoyé par le processus d'affichage
             int flag = 0;
@@ -237,10 +243,17 @@ int main(int argc, char *argv[])
                 MPI_Recv(&term, 1, MPI_INT, 0, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
                 simulation_continue = false;
             }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
 
+        // L'état final est toujours transmis, dans le dernier message
+        sender.flush();
+        header.running = 0;
+        sender.send(header, simu.vegetal_map(), simu.fire_map());
+        sender.flush();
+        double sim_s = std::chrono::duration<double>(total_sim_time).count();
+        std::cout << "[SIMULATION] " << step_count << " pas (" << step_count / sim_s << " pas/s) - trames envoyées : "
+                  << sender.sent() << ", sautées : " << sender.skipped() << std::endl;
+
         // Affichage final de la moyenne de simulation
         if (step_count > 0)
         {
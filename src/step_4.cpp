@@ -5,11 +5,15 @@
 #include <thread>
 #include <vector>
 #include <algorithm>
+#include <string>
 #include <cstdint>
 #include <memory>
 #include <SDL2/SDL.h>
 #include "model.hpp"
+#include "distributed_model.hpp"
 #include "display.hpp"
+#include "map_pyramid.hpp"
+#include "checkpoint.hpp"
 
 // Structure pour les paramètres de simulation
 struct ParamsType {
@@ -17,10 +21,19 @@ struct ParamsType {
     unsigned discretization{200};
     std::array<double,2> wind{1.0, 0.0};
     Model::LexicoIndices start{40, 100}; // Position initiale du feu (0.2, 0.5) * 200
+    Model::Engine engine{Model::Engine::sparse};
+    std::uint64_t seed{0};
+    unsigned rebalance{0}; // Intervalle d'équilibrage dynamique en pas de temps (0 : blocs fixes)
+    double fps{30.};       // Cadence d'affichage visée (images par seconde)
+    bool full{false};      // Blocs transmis en pleine résolution (enregistrement), sinon réduits à celle de la fenêtre
+    double max_wind{60.};
+    unsigned checkpoint_interval{0}; // Point de sauvegarde (MPI-IO) tous les checkpoint_interval pas (0 : aucun)
+    std::string checkpoint;
+    std::string restart;             // Point de sauvegarde à reprendre, écrit avec un nombre de processus quelconque
 };
 
-// Analyse des arguments de la ligne de commande
-void analyze_arg(int nargs, char* args[], ParamsType& params) {
+// Analyse des arguments de la ligne de commande ; faux si le moteur demandé est inconnu ou absent
+bool analyze_arg(int nargs, char* args[], ParamsType& params) {
     for (int i = 1; i < nargs; ++i) {
         std::string arg = args[i];
         if (arg == "-l" || arg == "--length") {
@@ -45,7 +58,41 @@ void analyze_arg(int nargs, char* args[], ParamsType& params) {
                 };
             }
         }
+        else if (arg == "-e" || arg == "--engine") {
+            if (i + 1 >= nargs) {
+                std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
+                return false;
+            }
+            std::string name = args[++i];
+            if (name != "sparse" && name != "dense") {
+                std::cerr << "[ERREUR] Moteur inconnu : " << name << " (sparse ou dense)" << std::endl;
+                return false;
+            }
+            params.engine = name == "dense" ? Model::Engine::dense : Model::Engine::sparse;
+        }
+        else if (arg == "--seed") {
+            if (i + 1 < nargs) params.seed = std::stoull(args[++i]);
+        }
+        else if (arg == "-r" || arg == "--rebalance") {
+            if (i + 1 < nargs) params.rebalance = std::stoul(args[++i]);
+        }
+        else if (arg == "--fps") {
+            if (i + 1 < nargs) params.fps = std::stod(args[++i]);
+        }
+        else if (arg == "-f" || arg == "--full") {
+            params.full = true;
+        }
+        else if (arg == "--checkpoint") {
+            if (i + 2 < nargs) {
+                params.checkpoint_interval = std::stoul(args[++i]);
+                params.checkpoint = args[++i];
+            }
+        }
+        else if (arg == "--restart") {
+            if (i + 1 < nargs) params.restart = args[++i];
+        }
     }
+    return true;
 }
 
 // Vérification des paramètres
@@ -82,7 +129,27 @@ int main(int argc, char* argv[]) {
     
     // Paramètres de la simulation
     ParamsType params;
-    analyze_arg(argc, argv, params);
+    if (!analyze_arg(argc, argv, params)) {
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+        return EXIT_FAILURE;
+    }
+    // Reprise : les paramètres du modèle sont ceux de la simulation sauvegardée, lus par tous les processus
+    if (!params.restart.empty()) {
+        try {
+            CheckpointHeader header = read_checkpoint_header(params.restart);
+            params.length = header.length;
+            params.discretization = header.geometry;
+            params.wind = {header.wind[0], header.wind[1]};
+            params.max_wind = header.max_wind;
+            params.seed = header.seed;
+            params.start = {0u, 0u};
+        }
+        catch (std::exception const& error) {
+            if (rank == 0) std::cerr << "[ERREUR] " << error.what() << std::endl;
+            MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+            return EXIT_FAILURE;
+        }
+    }
     if (!check_params(params)) {
         MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
         return EXIT_FAILURE;
@@ -91,9 +158,20 @@ int main(int argc, char* argv[]) {
     const int MAX_ITERATIONS = 500;  // Réduit le nombre maximum d'itérations
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    // Calculer les dimensions des tranches
-    int slice_height = params.discretization / (size - 1);
-    int slice_width = params.discretization;
+    // Communicateur des processus de calcul (rangs 1 à size-1 de MPI_COMM_WORLD)
+    MPI_Comm compute_comm;
+    MPI_Comm_split(MPI_COMM_WORLD, rank == 0 ? MPI_UNDEFINED : 1, rank, &compute_comm);
+    // Les processus de calcul réduisent leur bloc à la résolution de la fenêtre avant l'envoi : le volume
+    // reçu par l'affichage est alors proportionnel au nombre de pixels, quelle que soit la grille. Les
+    // frontières des blocs sont des multiples du facteur de réduction, les blocs réduits se juxtaposent
+    // donc exactement dans la grille réduite.
+    const int SCALE = 5;
+    // En-tête de chaque bloc : processus actif, facteur de réduction, bloc réduit {première ligne, lignes,
+    // première colonne, colonnes}, puis l'annonce d'un équilibrage possible au pas suivant
+    const int HEADER_SIZE = 7;
+    const int window = Displayer::window_size(params.discretization, SCALE);
+    const unsigned requested_factor = params.full ? 1u
+        : 1u << MapPyramid::level_for(params.discretization, params.discretization, window, window);
 
     if (rank == 0) {
         // Processus d'affichage
@@ -103,67 +181,112 @@ int main(int argc, char* argv[]) {
         std::cout << "  Vent : [" << params.wind[0] << ", " << params.wind[1] << "]" << std::endl;
         std::cout << "  Position initiale : (" << params.start.column << ", " << params.start.row << ")" << std::endl;
         std::cout << "  Nombre de processus : " << size << std::endl;
-        std::cout << "  Hauteur des tranches : " << slice_height << std::endl;
+        if (!params.restart.empty())
+            std::cout << "  Reprise du point de sauvegarde : " << params.restart << std::endl;
+
+        // Bloc (réduit) de chaque processus de calcul, décrit par un type MPI qui reçoit directement, à leurs
+        // adresses absolues, l'en-tête du processus puis ses deux cartes à leur place dans les cartes globales
+        // (le sous-tableau du bloc dans la végétation, puis le même dans le feu). L'en-tête voyage donc avec
+        // les cartes, dans la même collective. Le facteur de réduction effectif fixe la taille des cartes globales.
+        unsigned factor = 0, width = 0;
+        std::vector<std::uint8_t> global_vegetal, global_fire;
+        std::vector<unsigned> headers(HEADER_SIZE * std::size_t(size));
+        std::vector<MPI_Datatype> block_types(size, MPI_BYTE);
+        std::vector<std::array<unsigned,4>> blocks(size, {0u, 0u, 0u, 0u});
+        auto set_block = [&](int source, unsigned const* block) {
+            if (std::equal(block, block + 4, blocks[source].begin())) return;
+            if (blocks[source][1] == 0)
+                std::cout << "  Bloc du processus " << source << " : lignes " << block[0] << " à " << block[0] + block[1] - 1
+                          << ", colonnes " << block[2] << " à " << block[2] + block[3] - 1 << std::endl;
+            std::copy(block, block + 4, blocks[source].begin());
+            if (block_types[source] != MPI_BYTE) MPI_Type_free(&block_types[source]);
+            int sizes[2]    = {int(width), int(width)};
+            int subsizes[2] = {int(block[1]), int(block[3])};
+            int starts[2]   = {int(block[0]), int(block[2])};
+            MPI_Datatype subarray;
+            MPI_Type_create_subarray(2, sizes, subsizes, starts, MPI_ORDER_C, MPI_UINT8_T, &subarray);
+            MPI_Aint vegetal_address, fire_address;
+            MPI_Get_address(global_vegetal.data(), &vegetal_address);
+            MPI_Get_address(global_fire.data(), &fire_address);
+            MPI_Aint header_address;
+            MPI_Get_address(headers.data() + HEADER_SIZE * source, &header_address);
+            int lengths[3] = {HEADER_SIZE, 1, 1};
+            MPI_Aint displacements[3] = {header_address, vegetal_address, fire_address};
+            MPI_Datatype types[3] = {MPI_UNSIGNED, subarray, subarray};
+            MPI_Type_create_struct(3, lengths, displacements, types, &block_types[source]);
+            MPI_Type_commit(&block_types[source]);
+            MPI_Type_free(&subarray);
+        };
+        // Arguments de la collecte : rien à envoyer, un bloc à recevoir de chaque processus de calcul
+        std::vector<int> zeros(size, 0), recv_counts(size, 1);
+        std::vector<MPI_Datatype> send_types(size, MPI_BYTE);
+        recv_counts[0] = 0;
 
         // Initialisation de l'affichage
-        const int SCALE = 5;
-        auto displayer = Displayer::createOrGetInstance(params.discretization * SCALE, params.discretization * SCALE);
-        std::vector<std::uint8_t> global_vegetal(params.discretization * params.discretization);
-        std::vector<std::uint8_t> global_fire(params.discretization * params.discretization);
+        auto displayer = Displayer::createOrGetInstance(window, window);
+        std::uint64_t received_bytes = 0;
         bool running = true;
-        int iteration = 0;
+        bool stop_sent = false;
+        int iteration = 0, nb_displayed = 0;
+        // Les blocs sont reçus à chaque pas, mais l'image n'est redessinée qu'à la cadence visée
+        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(1.0 / params.fps));
+        auto next_display = std::chrono::steady_clock::now();
 
-        // Boucle principale d'affichage
-        while (running && iteration < MAX_ITERATIONS) {
+        // Boucle principale d'affichage : à chaque pas, une collective reçoit en-têtes et blocs
+        bool layout_pending = true;
+        while (running) {
             SDL_Event event;
             while (SDL_PollEvent(&event)) {
-                if (event.type == SDL_QUIT) {
-                    running = false;
-                    // Informer tous les processus de calcul de l'arrêt
-                    for (int i = 1; i < size; ++i) {
-                        MPI_Send(&running, 1, MPI_CXX_BOOL, i, 0, MPI_COMM_WORLD);
-                    }
-                    break;
+                if (event.type == SDL_QUIT && !stop_sent) {
+                    // Les processus de calcul s'arrêtent tous au même pas : la demande est adressée
+                    // au premier, qui la diffuse aux autres pendant la réduction de fin de pas
+                    bool stop = true;
+                    MPI_Send(&stop, 1, MPI_CXX_BOOL, 1, 0, MPI_COMM_WORLD);
+                    stop_sent = true;
+                }
+                else {
+                    displayer->handle_event(event);
                 }
             }
-            if (!running) break;
 
-            // Collecter les données de tous les processus de calcul
-            bool all_finished = true;
-            for (int source = 1; source < size; ++source) {
-                MPI_Status status;
-                bool proc_running;
-                MPI_Recv(&proc_running, 1, MPI_CXX_BOOL, source, 1, MPI_COMM_WORLD, &status);
-                all_finished = all_finished && !proc_running;
-
-                int start_row = (source - 1) * slice_height;
-                int real_slice_size = slice_height * slice_width;
-
-                // Recevoir les données de la tranche
-                std::vector<std::uint8_t> slice_vegetal(real_slice_size);
-                std::vector<std::uint8_t> slice_fire(real_slice_size);
-                MPI_Recv(slice_vegetal.data(), real_slice_size, MPI_UINT8_T, source, 2, MPI_COMM_WORLD, &status);
-                MPI_Recv(slice_fire.data(), real_slice_size, MPI_UINT8_T, source, 3, MPI_COMM_WORLD, &status);
-
-                // Copier les données dans les tableaux globaux
-                for (int i = 0; i < slice_height; ++i) {
-                    std::copy(slice_vegetal.begin() + i * slice_width,
-                            slice_vegetal.begin() + (i + 1) * slice_width,
-                            global_vegetal.begin() + (start_row + i) * slice_width);
-                    std::copy(slice_fire.begin() + i * slice_width,
-                            slice_fire.begin() + (i + 1) * slice_width,
-                            global_fire.begin() + (start_row + i) * slice_width);
+            // Les types de réception doivent connaître la taille des blocs avant la collective : les en-têtes
+            // sont d'abord collectés seuls au premier pas et quand l'en-tête précédent annonce un pas
+            // d'équilibrage, seuls pas où un bloc peut changer. Les autres pas n'ont qu'une collective.
+            if (layout_pending) {
+                unsigned header[HEADER_SIZE] = {};
+                MPI_Gather(header, HEADER_SIZE, MPI_UNSIGNED, headers.data(), HEADER_SIZE, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
+                if (factor == 0) {
+                    // Les cartes globales sont allouées une seule fois : les types des blocs désignent leurs adresses
+                    factor = headers[HEADER_SIZE + 1];
+                    width = (params.discretization + factor - 1) / factor;
+                    global_vegetal.assign(std::size_t(width) * width, 0);
+                    global_fire.assign(std::size_t(width) * width, 0);
+                    std::cout << "  Transfert : " << (factor == 1 ? "pleine résolution" : "réduit d'un facteur " + std::to_string(factor))
+                              << " (" << width << " x " << width << " cases)" << std::endl;
                 }
+                for (int source = 1; source < size; ++source)
+                    set_block(source, headers.data() + HEADER_SIZE * source + 2);
             }
-
-            displayer->update(global_vegetal, global_fire);
-            iteration++;
-
-            if (all_finished) {
-                running = false;
+            // En-têtes et blocs : une seule collective, chaque bloc arrive directement à sa place dans les cartes globales
+            MPI_Alltoallw(MPI_BOTTOM, zeros.data(), zeros.data(), send_types.data(),
+                          MPI_BOTTOM, recv_counts.data(), zeros.data(), block_types.data(), MPI_COMM_WORLD);
+            bool any_running = false;
+            for (int source = 1; source < size; ++source) {
+                unsigned const* source_header = headers.data() + HEADER_SIZE * source;
+                received_bytes += 2 * std::uint64_t(source_header[3]) * source_header[5];
+                any_running = any_running || source_header[0] != 0;
             }
+            running = any_running;
+            layout_pending = headers[HEADER_SIZE + 6] != 0;
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            auto now = std::chrono::steady_clock::now();
+            if (!stop_sent && (now >= next_display || !running)) {
+                displayer->update(global_vegetal, global_fire);
+                next_display = now + period;
+                nb_displayed++;
+            }
+            iteration++;
         }
 
         auto end_time = std::chrono::high_resolution_clock::now();
@@ -172,78 +295,126 @@ int main(int argc, char* argv[]) {
         std::cout << "  Nombre d'itérations : " << iteration << std::endl;
         std::cout << "  Temps total : " << elapsed_seconds.count() << " secondes" << std::endl;
         std::cout << "  Temps moyen par itération : " << elapsed_seconds.count() / iteration * 1000 << " ms" << std::endl;
+        std::cout << "  Volume reçu par pas : " << received_bytes / std::max(iteration, 1) << " octets" << std::endl;
+        std::cout << "  Pas simulés par seconde : " << iteration / elapsed_seconds.count()
+                  << " - images affichées par seconde : " << nb_displayed / elapsed_seconds.count() << std::endl;
+        for (int source = 1; source < size; ++source)
+            if (block_types[source] != MPI_BYTE) MPI_Type_free(&block_types[source]);
     }
     else {
-        // Processus de calcul
-        int start_row = (rank - 1) * slice_height;
+        // Processus de calcul : chacun ne simule que son bloc de la grille
         bool running = true;
         int iteration = 0;
+        auto update_time = std::chrono::high_resolution_clock::duration::zero();
 
-        // Créer le modèle avec la taille totale
-        Model simu(params.length, params.discretization, params.wind, params.start);
-        
-        // Boucle principale de calcul
-        while (running && iteration < MAX_ITERATIONS) {
-            // Vérifier les messages d'arrêt
-            MPI_Status status;
-            int flag;
-            MPI_Iprobe(0, 0, MPI_COMM_WORLD, &flag, &status);
-            if (flag) {
-                MPI_Recv(&running, 1, MPI_CXX_BOOL, 0, 0, MPI_COMM_WORLD, &status);
-                break;
+        {
+            DistributedModel simu(compute_comm, params.length, params.discretization, params.wind, params.start,
+                                  params.max_wind, params.seed, {0, 0}, requested_factor);
+            // Les erreurs de lecture ou d'écriture des points de sauvegarde sont levées sur tous les processus
+            // de calcul ; l'affichage, qui attend leurs blocs, ne peut qu'être interrompu
+            auto abort_on_error = [&](auto operation) {
+                try {
+                    operation();
+                }
+                catch (std::exception const& error) {
+                    if (rank == 1) std::cerr << "[ERREUR] " << error.what() << std::endl;
+                    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+                }
+            };
+            if (!params.restart.empty()) {
+                abort_on_error([&] { simu.load_checkpoint(params.restart); });
+                if (rank == 1)
+                    std::cout << "[Reprise] pas " << simu.local().time_step() << std::endl;
             }
+            // Facteur effectif : réduit si la grille n'a pas assez de lignes réduites pour tous les processus
+            const unsigned factor = simu.granularity();
+            unsigned level = 0;
+            while ((1u << level) < factor) ++level;
+            MapPyramid pyramid;
+            // Envoi du bloc réduit à l'affichage : l'en-tête et les deux cartes décrits par un seul type, à leurs
+            // adresses absolues. Les tampons de la pyramide (ou du modèle) sont stables, le type n'est reconstruit
+            // que si leurs adresses ou la taille du bloc changent.
+            std::vector<int> zeros(size, 0), send_counts(size, 0);
+            std::vector<MPI_Datatype> send_types(size, MPI_BYTE), recv_types(size, MPI_BYTE);
+            send_counts[0] = 1;
+            MapPyramid::Level sent_tile{nullptr, nullptr, 0, 0, 0};
+            unsigned header[HEADER_SIZE] = {};
+            bool layout_pending = true;
+            simu.local().set_engine(params.engine);
+            simu.set_rebalance_interval(params.rebalance);
+            unsigned nb_rebalances = 0;
 
-            // Échanger les cellules fantômes avec les voisins
-            if (rank > 1) {
-                MPI_Send(simu.fire_map().data() + start_row * slice_width, 
-                        slice_width, MPI_UINT8_T, rank - 1, 3, MPI_COMM_WORLD);
-                std::vector<std::uint8_t> ghost_line(slice_width);
-                MPI_Recv(ghost_line.data(), slice_width, MPI_UINT8_T, 
-                        rank - 1, 4, MPI_COMM_WORLD, &status);
-                std::copy(ghost_line.begin(), ghost_line.end(), 
-                        simu.fire_map().data() + (start_row - 1) * slice_width);
-            }
+            // Boucle principale de calcul
+            while (running) {
+                auto step_start = std::chrono::high_resolution_clock::now();
+                running = simu.update();
+                update_time += std::chrono::high_resolution_clock::now() - step_start;
+                iteration++;
 
-            if (rank < size - 1) {
-                MPI_Send(simu.fire_map().data() + (start_row + slice_height - 1) * slice_width,
-                        slice_width, MPI_UINT8_T, rank + 1, 4, MPI_COMM_WORLD);
-                std::vector<std::uint8_t> ghost_line(slice_width);
-                MPI_Recv(ghost_line.data(), slice_width, MPI_UINT8_T,
-                        rank + 1, 3, MPI_COMM_WORLD, &status);
-                std::copy(ghost_line.begin(), ghost_line.end(),
-                        simu.fire_map().data() + (start_row + slice_height) * slice_width);
-            }
+                // Demande d'arrêt de l'affichage, reçue par le premier processus de calcul
+                int stop = 0;
+                if (rank == 1) {
+                    MPI_Iprobe(0, 0, MPI_COMM_WORLD, &stop, MPI_STATUS_IGNORE);
+                    if (stop) {
+                        bool message;
+                        MPI_Recv(&message, 1, MPI_CXX_BOOL, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                    }
+                }
+                MPI_Allreduce(MPI_IN_PLACE, &stop, 1, MPI_INT, MPI_LOR, compute_comm);
+                const bool interrupted = running && (stop || iteration >= MAX_ITERATIONS);
+                running = running && !interrupted;
+                if (rank == 1 && simu.rebalances() != nb_rebalances) {
+                    std::cout << "[Équilibrage] pas " << simu.local().time_step() << " : déséquilibre "
+                              << simu.imbalance_before() << " -> " << simu.imbalance_after() << std::endl;
+                }
+                nb_rebalances = simu.rebalances();
+                // Sauvegarde périodique, et à l'arrêt avant l'extinction du feu pour pouvoir reprendre
+                if (params.checkpoint_interval > 0
+                    && (interrupted || (running && simu.local().time_step() % params.checkpoint_interval == 0))) {
+                    abort_on_error([&] { simu.save_checkpoint(params.checkpoint); });
+                    if (rank == 1)
+                        std::cout << "[Sauvegarde] pas " << simu.local().time_step() << " : " << params.checkpoint << std::endl;
+                }
 
-            // Mettre à jour la simulation
-            running = simu.update();
-
-            // Envoyer les résultats au processus d'affichage
-            auto vegetal_map = simu.vegetal_map();
-            auto fire_map = simu.fire_map();
-            
-            // Envoyer uniquement la tranche locale
-            int real_slice_size = slice_height * slice_width;
-            std::vector<std::uint8_t> slice_vegetal(real_slice_size);
-            std::vector<std::uint8_t> slice_fire(real_slice_size);
-            
-            for (int i = 0; i < slice_height; ++i) {
-                std::copy(vegetal_map.begin() + (start_row + i) * slice_width,
-                        vegetal_map.begin() + (start_row + i + 1) * slice_width,
-                        slice_vegetal.begin() + i * slice_width);
-                std::copy(fire_map.begin() + (start_row + i) * slice_width,
-                        fire_map.begin() + (start_row + i + 1) * slice_width,
-                        slice_fire.begin() + i * slice_width);
+                // Envoyer uniquement le bloc local, réduit (feu maximal, végétation moyenne)
+                Model::Domain block = simu.domain();
+                MapPyramid::Level tile = pyramid.reduce({simu.local().vegetal_map().data(), simu.local().fire_map().data(),
+                                                         block.nb_columns, block.nb_rows, block.nb_columns}, level);
+                if (tile.vegetation != sent_tile.vegetation || tile.fire != sent_tile.fire
+                    || tile.width != sent_tile.width || tile.height != sent_tile.height) {
+                    if (send_types[0] != MPI_BYTE) MPI_Type_free(&send_types[0]);
+                    int count = int(tile.width * tile.height);
+                    int lengths[3] = {HEADER_SIZE, count, count};
+                    MPI_Aint addresses[3];
+                    MPI_Get_address(header, &addresses[0]);
+                    MPI_Get_address(tile.vegetation, &addresses[1]);
+                    MPI_Get_address(tile.fire, &addresses[2]);
+                    MPI_Datatype types[3] = {MPI_UNSIGNED, MPI_UINT8_T, MPI_UINT8_T};
+                    MPI_Type_create_struct(3, lengths, addresses, types, &send_types[0]);
+                    MPI_Type_commit(&send_types[0]);
+                    sent_tile = tile;
+                }
+                // L'équilibrage a lieu pendant update(), aux pas multiples de l'intervalle : tous les processus
+                // savent donc d'avance si le prochain pas peut déplacer les blocs et l'annoncent à l'affichage.
+                const std::size_t next_step = simu.local().time_step() + 1;
+                const bool may_rebalance = params.rebalance > 0 && next_step % params.rebalance == 0;
+                const unsigned values[HEADER_SIZE] = {running ? 1u : 0u, factor, block.first_row / factor, tile.height,
+                                                      block.first_column / factor, tile.width, may_rebalance ? 1u : 0u};
+                std::copy(values, values + HEADER_SIZE, header);
+                if (layout_pending)
+                    MPI_Gather(header, HEADER_SIZE, MPI_UNSIGNED, nullptr, HEADER_SIZE, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
+                layout_pending = may_rebalance;
+                MPI_Alltoallw(MPI_BOTTOM, send_counts.data(), zeros.data(), send_types.data(),
+                              nullptr, zeros.data(), zeros.data(), recv_types.data(), MPI_COMM_WORLD);
             }
-            
-            MPI_Send(&running, 1, MPI_CXX_BOOL, 0, 1, MPI_COMM_WORLD);
-            MPI_Send(slice_vegetal.data(), real_slice_size, MPI_UINT8_T, 0, 2, MPI_COMM_WORLD);
-            MPI_Send(slice_fire.data(), real_slice_size, MPI_UINT8_T, 0, 3, MPI_COMM_WORLD);
-
-            iteration++;
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            if (send_types[0] != MPI_BYTE) MPI_Type_free(&send_types[0]);
         }
+        MPI_Comm_free(&compute_comm);
+
+        std::cout << "[Processus " << rank << "] Temps moyen par update : "
+                  << std::chrono::duration<double, std::milli>(update_time).count() / iteration << " ms" << std::endl;
     }
 
     MPI_Finalize();
     return EXIT_SUCCESS;
-} 
\ No newline at end of file
+}
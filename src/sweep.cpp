@@ -0,0 +1,208 @@
+#include <string>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "model.hpp"
+#include "model_pool.hpp"
+
+// Balayage de paramètres sans affichage : les scénarios (vent, foyer, graine) sont lus dans un fichier,
+// distribués aux threads et calculés chacun par un modèle mono-thread emprunté à une réserve préallouée
+// (ModelPool) : une simulation courte ne paie ni allocation ni défauts de page. Une ligne de résumé par
+// scénario, dans l'ordre du fichier.
+//
+// Fichier de scénarios : une ligne par scénario, « vx vy x y [graine [pas]] » (foyer en fraction du
+// terrain, pas : 0 ou absent jusqu'à l'extinction) ; les lignes vides et celles qui commencent par # sont
+// ignorées.
+struct ParamsType {
+    double length{1.};
+    unsigned discretization{100u};
+    Model::Engine engine{Model::Engine::sparse};
+    std::string scenarios;
+    std::string output;                   // Fichier CSV des résumés, vide : sortie standard
+    bool pool{true};                      // Faux : un modèle construit par scénario, pour comparaison
+};
+
+struct Scenario {
+    std::array<double,2> wind{0.,0.};
+    std::array<double,2> start{0.5,0.5};
+    std::uint64_t seed{0};
+    std::size_t max_steps{0};
+};
+
+struct Summary {
+    std::size_t steps{0};
+    std::size_t burnt_cells{0};           // Cases atteintes par le feu
+    std::size_t final_front{0};
+    double seconds{0.};                   // Remise à zéro (ou construction) et calcul
+};
+
+bool analyze_arg(int nargs, char* args[], ParamsType& params) {
+    for (int i = 1; i < nargs; ++i) {
+        std::string arg = args[i];
+        // Vrai si l'option est suivie de ses nb_values valeurs
+        auto has_values = [&](int nb_values) {
+            if (i + nb_values < nargs) return true;
+            std::cerr << "[ERREUR] Valeur manquante pour " << arg << std::endl;
+            return false;
+        };
+        if (arg == "-l" || arg == "--length") {
+            if (!has_values(1)) return false;
+            params.length = std::stod(args[++i]);
+        }
+        else if (arg == "-d" || arg == "--discretization") {
+            if (!has_values(1)) return false;
+            params.discretization = std::stoul(args[++i]);
+        }
+        else if (arg == "-e" || arg == "--engine") {
+            if (!has_values(1)) return false;
+            std::string name = args[++i];
+            if (name != "sparse" && name != "dense") {
+                std::cerr << "[ERREUR] Moteur inconnu : " << name << " (sparse ou dense)" << std::endl;
+                return false;
+            }
+            params.engine = name == "dense" ? Model::Engine::dense : Model::Engine::sparse;
+        }
+        else if (arg == "-o" || arg == "--output") {
+            if (!has_values(1)) return false;
+            params.output = args[++i];
+        }
+        else if (arg == "--no-pool") {
+            params.pool = false;
+        }
+        else if (arg[0] != '-' && params.scenarios.empty()) {
+            params.scenarios = arg;
+        }
+        else {
+            if (arg != "-h" && arg != "--help")
+                std::cerr << "[ERREUR] Option inconnue : " << arg << std::endl;
+            std::cout << "Usage : " << args[0] << " scénarios [-l longueur] [-d cases] [-e sparse|dense] [-o résumé.csv]"
+                      << " [--no-pool]" << std::endl;
+            return false;
+        }
+    }
+    if (params.scenarios.empty()) {
+        std::cerr << "[ERREUR] Fichier de scénarios manquant." << std::endl;
+        return false;
+    }
+    if (params.length <= 0 || params.discretization == 0) {
+        std::cerr << "[ERREUR] La longueur et le nombre de cellules doivent être positifs." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool read_scenarios(std::string const& path, std::vector<Scenario>& scenarios) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "[ERREUR] Impossible d'ouvrir " << path << std::endl;
+        return false;
+    }
+    std::string line;
+    for (int number = 1; std::getline(file, line); ++number) {
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first) || first[0] == '#') continue;
+        Scenario scenario;
+        fields.clear();
+        fields.str(line);
+        if (!(fields >> scenario.wind[0] >> scenario.wind[1] >> scenario.start[0] >> scenario.start[1])
+            || scenario.start[0] < 0 || scenario.start[0] > 1 || scenario.start[1] < 0 || scenario.start[1] > 1) {
+            std::cerr << "[ERREUR] " << path << ", ligne " << number << " : « vx vy x y [graine [pas]] » attendu,"
+                      << " foyer entre 0 et 1" << std::endl;
+            return false;
+        }
+        if (fields >> scenario.seed) fields >> scenario.max_steps;
+        scenarios.push_back(scenario);
+    }
+    return true;
+}
+
+// Calcul d'un scénario jusqu'à l'extinction ou au nombre de pas demandé
+Summary run(Model& simu, Scenario const& scenario) {
+    Summary summary;
+    bool running = true;
+    while (running && (scenario.max_steps == 0 || summary.steps < scenario.max_steps)) {
+        running = simu.update();
+        summary.steps++;
+    }
+    MapView vegetation = simu.vegetal_map(), fire = simu.fire_map();
+    for (std::size_t cell = 0; cell < vegetation.size(); ++cell)
+        summary.burnt_cells += vegetation[cell] < 255u || fire[cell] != 0u;
+    summary.final_front = simu.fire_front().size();
+    return summary;
+}
+
+int main(int nargs, char* args[]) {
+    ParamsType params;
+    std::vector<Scenario> scenarios;
+    if (!analyze_arg(nargs, args, params) || !read_scenarios(params.scenarios, scenarios))
+        return EXIT_FAILURE;
+
+    const unsigned d = params.discretization;
+#if defined(_OPENMP)
+    const std::size_t nb_threads = std::size_t(omp_get_max_threads());
+#else
+    const std::size_t nb_threads = 1;
+#endif
+    auto start_time = std::chrono::steady_clock::now();
+    std::unique_ptr<ModelPool> pool;
+    if (params.pool)
+        pool = std::make_unique<ModelPool>(params.length, d, nb_threads, 10.0);
+    double pool_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    std::vector<Summary> summaries(scenarios.size());
+#pragma omp parallel for schedule(dynamic)
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        Scenario const& scenario = scenarios[i];
+        const Model::LexicoIndices start{std::min(unsigned(scenario.start[0] * d), d - 1),
+                                         std::min(unsigned(scenario.start[1] * d), d - 1)};
+        auto scenario_start = std::chrono::steady_clock::now();
+        if (pool) {
+            ModelPool::Lease simu = pool->acquire(scenario.wind, start, scenario.seed);
+            simu->set_engine(params.engine);
+            simu->set_threads(1);
+            summaries[i] = run(*simu, scenario);
+        }
+        else {
+            Model simu(params.length, d, scenario.wind, start, 10.0, scenario.seed);
+            simu.set_engine(params.engine);
+            simu.set_threads(1);
+            summaries[i] = run(simu, scenario);
+        }
+        summaries[i].seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - scenario_start).count();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    std::ofstream file;
+    if (!params.output.empty()) {
+        file.open(params.output);
+        if (!file) {
+            std::cerr << "[ERREUR] Impossible de créer " << params.output << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream& out = params.output.empty() ? std::cout : file;
+    out << "scenario,wind_x,wind_y,start_x,start_y,seed,steps,burnt_cells,burnt_fraction,final_front,seconds\n";
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        Scenario const& scenario = scenarios[i];
+        Summary const& summary = summaries[i];
+        out << i << "," << scenario.wind[0] << "," << scenario.wind[1] << "," << scenario.start[0] << ","
+            << scenario.start[1] << "," << scenario.seed << "," << summary.steps << "," << summary.burnt_cells << ","
+            << double(summary.burnt_cells) / (double(d) * d) << "," << summary.final_front << "," << summary.seconds << "\n";
+    }
+    out.flush();
+    std::cerr << "Scénarios : " << scenarios.size() << " - threads : " << nb_threads << " - temps : " << seconds << " s"
+              << (pool ? " (réserve de " + std::to_string(nb_threads) + " modèles : " + std::to_string(pool_seconds) + " s)"
+                       : std::string(" (un modèle construit par scénario)"))
+              << std::endl;
+    return EXIT_SUCCESS;
+}